@@ -20,9 +20,22 @@
 
 @property (nonatomic, strong) NSDictionary *font;
 
+/**
+ * Rasterize the group's content once and composite the bitmap on later draws
+ * until the group, one of its descendants or the device scale changes.
+ */
+@property (nonatomic, assign) BOOL shouldRasterize;
+
 - (void)renderPathTo:(CGContextRef)context rect:(CGRect)rect;
 - (void)renderGroupTo:(CGContextRef)context rect:(CGRect)rect;
 
+/**
+ * Whether the rendered content may be cached, and for how many device
+ * transforms. Definitions rendered for each of their references override these.
+ */
+- (BOOL)isRasterCacheable;
+- (NSUInteger)rasterCacheCapacity;
+
 - (ABI44_0_0RNSVGGlyphContext *)getGlyphContext;
 - (void)pushGlyphContext;
 - (void)popGlyphContext;
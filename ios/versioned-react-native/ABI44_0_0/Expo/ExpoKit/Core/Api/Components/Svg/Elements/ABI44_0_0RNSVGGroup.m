@@ -9,10 +9,33 @@
 #import "ABI44_0_0RNSVGGroup.h"
 #import "ABI44_0_0RNSVGClipPath.h"
 #import "ABI44_0_0RNSVGMask.h"
+#import "ABI44_0_0RNSVGForeignObject.h"
+#import "ABI44_0_0RNSVGUse.h"
+#import "ABI44_0_0RNSVGText.h"
+#import "ABI44_0_0RNSVGPainterBrush.h"
+#import "ABI44_0_0RNSVGRasterCache.h"
+#import "ABI44_0_0RNSVGSpatialIndex.h"
 
 @implementation ABI44_0_0RNSVGGroup
 {
     ABI44_0_0RNSVGGlyphContext *_glyphContext;
+    ABI44_0_0RNSVGSpatialIndex *_hitTestIndex;
+    ABI44_0_0RNSVGRasterCache *_rasterCache;
+    BOOL _rasterBoundsRecorded;
+    BOOL _rasterCacheUnsupported;
+
+    // Inherited attributes the cached content was rendered with.
+    ABI44_0_0RNSVGBrush *_rasterFill;
+    CGFloat _rasterFillOpacity;
+    ABI44_0_0RNSVGCGFCRule _rasterFillRule;
+    ABI44_0_0RNSVGBrush *_rasterStroke;
+    CGFloat _rasterStrokeOpacity;
+    ABI44_0_0RNSVGLength *_rasterStrokeWidth;
+    CGLineCap _rasterStrokeLinecap;
+    CGLineJoin _rasterStrokeLinejoin;
+    CGFloat _rasterStrokeMiterlimit;
+    NSArray<ABI44_0_0RNSVGLength *> *_rasterStrokeDasharray;
+    CGFloat _rasterStrokeDashoffset;
 }
 
 - (void)setFont:(NSDictionary*)font
@@ -25,11 +48,39 @@
     _font = font;
 }
 
+- (void)setShouldRasterize:(BOOL)shouldRasterize
+{
+    if (shouldRasterize == _shouldRasterize) {
+        return;
+    }
+
+    [self invalidate];
+    _shouldRasterize = shouldRasterize;
+}
+
+- (void)invalidate
+{
+    // Descendants invalidate their container, so this also runs when anything
+    // inside the group changes. Merged attributes are compared when drawing.
+    if (!self.merging) {
+        [self clearRasterCache];
+    }
+    [super invalidate];
+}
+
+- (void)clearChildCache
+{
+    [self clearRasterCache];
+    [super clearChildCache];
+}
+
 - (void)renderLayerTo:(CGContextRef)context rect:(CGRect)rect
 {
     [self clip:context];
     [self setupGlyphContext:context];
-    [self renderGroupTo:context rect:rect];
+    if (![self renderRasterCacheTo:context rect:rect]) {
+        [self renderGroupTo:context rect:rect];
+    }
 }
 
 - (void)renderGroupTo:(CGContextRef)context rect:(CGRect)rect
@@ -55,6 +106,7 @@
             }
 
             [svgNode renderTo:context rect:rect];
+            [self updateHitTestIndexForNode:svgNode];
 
             CGRect nodeRect = svgNode.clientRect;
             if (!CGRectIsEmpty(nodeRect)) {
@@ -192,6 +244,7 @@
         }
     }
 
+    NSSet<ABI44_0_0RNSVGNode *> *candidates = _hitTestIndex.count ? [_hitTestIndex nodesAtPoint:transformed] : nil;
     for (ABI44_0_0RNSVGView *node in [self.subviews reverseObjectEnumerator]) {
         if ([node isKindOfClass:[ABI44_0_0RNSVGNode class]]) {
             if ([node isKindOfClass:[ABI44_0_0RNSVGMask class]]) {
@@ -201,6 +254,10 @@
             if (event) {
                 svgNode.active = NO;
             }
+            // Active nodes keep receiving the touch wherever it moves.
+            if (candidates && !svgNode.active && ![candidates containsObject:svgNode] && [_hitTestIndex containsNode:svgNode]) {
+                continue;
+            }
             ABI44_0_0RNSVGPlatformView *hitChild = [svgNode hitTest:transformed withEvent:event];
             if (hitChild) {
                 svgNode.active = YES;
@@ -223,6 +280,23 @@
     return nil;
 }
 
+- (void)updateHitTestIndexForNode:(ABI44_0_0RNSVGNode *)node
+{
+    if (!_hitTestIndex) {
+        if (![ABI44_0_0RNSVGSpatialIndex shouldIndexChildren:self.subviews]) {
+            return;
+        }
+        _hitTestIndex = [ABI44_0_0RNSVGSpatialIndex new];
+    }
+    [_hitTestIndex updateNode:node];
+}
+
+- (void)willRemoveSubview:(ABI44_0_0RNSVGPlatformView *)subview
+{
+    [_hitTestIndex removeNode:(ABI44_0_0RNSVGNode *)subview];
+    [super willRemoveSubview:subview];
+}
+
 - (void)parseReference
 {
     self.dirty = false;
@@ -249,4 +323,203 @@
     }];
 }
 
+#pragma mark - Raster cache
+
+- (BOOL)isRasterCacheable
+{
+    // Templates are rendered at a different transform by every `Use`.
+    return [self class] == [ABI44_0_0RNSVGGroup class] && !self.name;
+}
+
+- (NSUInteger)rasterCacheCapacity
+{
+    return 1;
+}
+
+- (void)clearRasterCache
+{
+    [_rasterCache removeAllEntries];
+    _rasterBoundsRecorded = NO;
+    _rasterCacheUnsupported = NO;
+}
+
+/**
+ * Composites the cached bitmap of the group's content when shouldRasterize is
+ * set, rasterizing it first on a cache miss. Returns NO when the content has
+ * to be rendered directly instead.
+ *
+ * Geometry (bounds, hit areas, ctm) of the group and its descendants is kept
+ * from the last direct render, which is still accurate while nothing changed.
+ */
+- (BOOL)renderRasterCacheTo:(CGContextRef)context rect:(CGRect)rect
+{
+    if (!self.shouldRasterize || _rasterCacheUnsupported || ![self isRasterCacheable]) {
+        return NO;
+    }
+    if ([ABI44_0_0RNSVGRasterCache isRasterizing]) {
+        // The content ends up in the bitmap of an ancestor, which is cached.
+        return NO;
+    }
+
+    if (_rasterCache.count && ![self hasRasterCacheAttributes]) {
+        [self clearRasterCache];
+    }
+    if ([_rasterCache drawInContext:context]) {
+        return YES;
+    }
+    if (!_rasterBoundsRecorded) {
+        // The first render after a change records the bounds to rasterize.
+        _rasterBoundsRecorded = YES;
+        return NO;
+    }
+    if (![self canRasterizeContent]) {
+        _rasterCacheUnsupported = YES;
+        return NO;
+    }
+
+    CGRect bounds = [self rasterContentBounds];
+    if (!_rasterCache) {
+        _rasterCache = [[ABI44_0_0RNSVGRasterCache alloc] initWithCapacity:[self rasterCacheCapacity]];
+    }
+    BOOL rasterized = [_rasterCache rasterizeBounds:bounds inContext:context renderer:^(CGContextRef bitmap, CGAffineTransform offset) {
+        // Descendants derive their ctm from the svg view's initial CTM, shift
+        // it by the same offset so the values they record stay unchanged.
+        ABI44_0_0RNSVGSvgView *svgView = self.svgView;
+        CGAffineTransform initialCTM = svgView.initialCTM;
+        CGAffineTransform invInitialCTM = svgView.invInitialCTM;
+        svgView.initialCTM = CGAffineTransformConcat(initialCTM, offset);
+        svgView.invInitialCTM = CGAffineTransformInvert(svgView.initialCTM);
+        [self renderGroupTo:bitmap rect:rect];
+        svgView.initialCTM = initialCTM;
+        svgView.invInitialCTM = invInitialCTM;
+    }];
+    if (!rasterized) {
+        _rasterCacheUnsupported = YES;
+        return NO;
+    }
+    [self storeRasterCacheAttributes];
+    [self markContentClean:self];
+    return YES;
+}
+
+/**
+ * Bounds of the content, including strokes, in the group's user space. The
+ * client rect of the children is in the svg view's space, map it back
+ * through the ctm recorded alongside it.
+ */
+- (CGRect)rasterContentBounds
+{
+    CGRect bounds = self.clientRect;
+    if (!CGRectIsEmpty(bounds)) {
+        bounds = CGRectApplyAffineTransform(bounds, CGAffineTransformInvert(self.ctm));
+    }
+    if (!CGRectIsEmpty(self.pathBounds)) {
+        bounds = CGRectIsEmpty(bounds) ? self.pathBounds : CGRectUnion(bounds, self.pathBounds);
+    }
+    return bounds;
+}
+
+/**
+ * Dirty nodes do not invalidate their container again. Definitions never
+ * reset the flag of their children, do it here so that changes made after
+ * rasterizing reach the group.
+ */
+- (void)markContentClean:(ABI44_0_0RNSVGPlatformView *)view
+{
+    for (ABI44_0_0RNSVGPlatformView *child in view.subviews) {
+        if ([child isKindOfClass:[ABI44_0_0RNSVGNode class]]) {
+            ((ABI44_0_0RNSVGNode *)child).dirty = false;
+            [self markContentClean:child];
+        }
+    }
+}
+
+- (BOOL)canRasterizeContent
+{
+    // The group's own clip and mask are applied around the cached content,
+    // attributes inherited by its children are not.
+    if ([self.fill isKindOfClass:[ABI44_0_0RNSVGPainterBrush class]] ||
+        [self.stroke isKindOfClass:[ABI44_0_0RNSVGPainterBrush class]]) {
+        return NO;
+    }
+    for (ABI44_0_0RNSVGPlatformView *child in self.subviews) {
+        if (![self canRasterizeNode:child]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/**
+ * Whether the rendering of the node only depends on nodes inside this group,
+ * so that invalidation of the group covers every change to it.
+ */
+- (BOOL)canRasterizeNode:(ABI44_0_0RNSVGPlatformView *)view
+{
+    if ([view isKindOfClass:[ABI44_0_0RNSVGMask class]] || [view isKindOfClass:[ABI44_0_0RNSVGClipPath class]]) {
+        // Not rendered in place.
+        return YES;
+    }
+    if (![view isKindOfClass:[ABI44_0_0RNSVGNode class]] ||
+        [view isKindOfClass:[ABI44_0_0RNSVGText class]] ||
+        [view isKindOfClass:[ABI44_0_0RNSVGUse class]] ||
+        [view isKindOfClass:[ABI44_0_0RNSVGForeignObject class]]) {
+        return NO;
+    }
+
+    ABI44_0_0RNSVGNode *node = (ABI44_0_0RNSVGNode *)view;
+    if (node.clipPath || node.mask || node.markerStart || node.markerMid || node.markerEnd) {
+        return NO;
+    }
+    if ([node isKindOfClass:[ABI44_0_0RNSVGRenderable class]]) {
+        ABI44_0_0RNSVGRenderable *renderable = (ABI44_0_0RNSVGRenderable *)node;
+        if ([renderable.fill isKindOfClass:[ABI44_0_0RNSVGPainterBrush class]] ||
+            [renderable.stroke isKindOfClass:[ABI44_0_0RNSVGPainterBrush class]]) {
+            return NO;
+        }
+    }
+
+    for (ABI44_0_0RNSVGPlatformView *child in node.subviews) {
+        if (![self canRasterizeNode:child]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/**
+ * Attributes descendants may inherit from this group. They are merged from
+ * the ancestors right before rendering, whose changes do not invalidate the
+ * group itself.
+ */
+- (BOOL)hasRasterCacheAttributes
+{
+    return self.fill == _rasterFill &&
+        self.fillOpacity == _rasterFillOpacity &&
+        self.fillRule == _rasterFillRule &&
+        self.stroke == _rasterStroke &&
+        self.strokeOpacity == _rasterStrokeOpacity &&
+        self.strokeWidth == _rasterStrokeWidth &&
+        self.strokeLinecap == _rasterStrokeLinecap &&
+        self.strokeLinejoin == _rasterStrokeLinejoin &&
+        self.strokeMiterlimit == _rasterStrokeMiterlimit &&
+        (self.strokeDasharray == _rasterStrokeDasharray || [self.strokeDasharray isEqualToArray:_rasterStrokeDasharray]) &&
+        self.strokeDashoffset == _rasterStrokeDashoffset;
+}
+
+- (void)storeRasterCacheAttributes
+{
+    _rasterFill = self.fill;
+    _rasterFillOpacity = self.fillOpacity;
+    _rasterFillRule = self.fillRule;
+    _rasterStroke = self.stroke;
+    _rasterStrokeOpacity = self.strokeOpacity;
+    _rasterStrokeWidth = self.strokeWidth;
+    _rasterStrokeLinecap = self.strokeLinecap;
+    _rasterStrokeLinejoin = self.strokeLinejoin;
+    _rasterStrokeMiterlimit = self.strokeMiterlimit;
+    _rasterStrokeDasharray = self.strokeDasharray;
+    _rasterStrokeDashoffset = self.strokeDashoffset;
+}
+
 @end
@@ -12,6 +12,25 @@
 
 @implementation ABI44_0_0RNSVGMask
 
+- (instancetype)init
+{
+    if (self = [super init]) {
+        // The mask content is rendered again for every masked element.
+        self.shouldRasterize = YES;
+    }
+    return self;
+}
+
+- (BOOL)isRasterCacheable
+{
+    return YES;
+}
+
+- (NSUInteger)rasterCacheCapacity
+{
+    return 8;
+}
+
 - (ABI44_0_0RNSVGPlatformView *)hitTest:(CGPoint)point withEvent:(UIEvent *)event
 {
     return nil;
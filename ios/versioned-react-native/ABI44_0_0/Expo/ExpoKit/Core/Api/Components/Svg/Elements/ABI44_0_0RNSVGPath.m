@@ -7,6 +7,7 @@
  */
 
 #import "ABI44_0_0RNSVGPath.h"
+#import "ABI44_0_0RNSVGPathCache.h"
 
 @implementation ABI44_0_0RNSVGPath
 {
@@ -22,7 +23,7 @@
     [self invalidate];
     _d = d;
     CGPathRelease(_path);
-    _path = CGPathRetain([d getPath]);
+    _path = [[ABI44_0_0RNSVGPathCache sharedCache] copyPathForParser:d];
 }
 
 - (CGPathRef)getPath:(CGContextRef)context
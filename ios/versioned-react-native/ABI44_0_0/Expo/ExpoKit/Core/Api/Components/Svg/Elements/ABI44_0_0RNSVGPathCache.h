@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+#import "ABI44_0_0RNSVGPathParser.h"
+
+/**
+ * Process-wide cache of parsed paths keyed by their path data, so that nodes
+ * with the same `d` share one immutable CGPath instead of parsing it again.
+ * Entries are evicted past the cost limit and under memory pressure.
+ */
+@interface ABI44_0_0RNSVGPathCache : NSObject
+
++ (instancetype)sharedCache;
+
+/**
+ * Returns the parsed path of the parser's data, following the Create rule.
+ */
+- (CGPathRef)copyPathForParser:(ABI44_0_0RNSVGPathParser *)parser CF_RETURNS_RETAINED;
+
+- (void)removeAllPaths;
+
+@end
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "ABI44_0_0RNSVGPathCache.h"
+
+// Path data longer than this is parsed directly, it is unlikely to repeat.
+static const NSUInteger kRNSVGPathCacheMaxDataLength = 64 * 1024;
+// Total length of the cached path data, parsed paths grow linearly with it.
+static const NSUInteger kRNSVGPathCacheTotalDataLength = 2 * 1024 * 1024;
+
+@implementation ABI44_0_0RNSVGPathCache
+{
+    NSCache<NSString *, id> *_paths;
+}
+
++ (instancetype)sharedCache
+{
+    static ABI44_0_0RNSVGPathCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [ABI44_0_0RNSVGPathCache new];
+    });
+    return sharedCache;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _paths = [NSCache new];
+        _paths.name = @"ABI44_0_0RNSVGPathCache";
+        _paths.totalCostLimit = kRNSVGPathCacheTotalDataLength;
+    }
+    return self;
+}
+
+/**
+ * The parser only keeps the path data it was created with, in its `_d` ivar,
+ * and does not expose it. Key-value coding falls back to that ivar.
+ */
++ (NSString *)pathDataOfParser:(ABI44_0_0RNSVGPathParser *)parser
+{
+    id data = [parser valueForKey:@"d"];
+    return [data isKindOfClass:[NSString class]] ? data : nil;
+}
+
+- (CGPathRef)copyPathForParser:(ABI44_0_0RNSVGPathParser *)parser
+{
+    NSString *data = [ABI44_0_0RNSVGPathCache pathDataOfParser:parser];
+    if (!data || data.length > kRNSVGPathCacheMaxDataLength) {
+        return CGPathRetain([parser getPath]);
+    }
+
+    id cached = [_paths objectForKey:data];
+    if (cached) {
+        return CGPathRetain((__bridge CGPathRef)cached);
+    }
+
+    // The parser may hand out a mutable path, store an immutable copy.
+    CGPathRef path = CGPathCreateCopy([parser getPath]);
+    if (path) {
+        [_paths setObject:(__bridge id)path forKey:[data copy] cost:data.length];
+    }
+    return path;
+}
+
+- (void)removeAllPaths
+{
+    [_paths removeAllObjects];
+}
+
+@end
@@ -16,10 +16,22 @@
 {
     if (self = [super init]) {
         _patternTransform = CGAffineTransformIdentity;
+        // The tile is rendered again for every shape filled with the pattern.
+        self.shouldRasterize = YES;
     }
     return self;
 }
 
+- (BOOL)isRasterCacheable
+{
+    return YES;
+}
+
+- (NSUInteger)rasterCacheCapacity
+{
+    return 8;
+}
+
 - (ABI44_0_0RNSVGPlatformView *)hitTest:(CGPoint)point withEvent:(UIEvent *)event
 {
     return nil;
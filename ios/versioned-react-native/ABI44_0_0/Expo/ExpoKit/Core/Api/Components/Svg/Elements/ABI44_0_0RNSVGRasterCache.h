@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+/**
+ * Bitmaps of rendered content, each keyed by the device transform it was
+ * rendered at. An entry is reused when the transform only differs by whole
+ * device pixels, the least recently used entry is evicted once the cache
+ * holds `capacity` entries. The bitmaps of all caches share a memory budget,
+ * exceeding it evicts the least recently used entries of any cache.
+ * Caches may be used from any thread, but each by one thread at a time.
+ */
+@interface ABI44_0_0RNSVGRasterCache : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/**
+ * Whether a cache is rasterizing content on the current thread. Content
+ * nested in it is better drawn directly than cached a second time.
+ */
++ (BOOL)isRasterizing;
+
+/**
+ * Composites the entry matching the context's CTM. Returns NO when there is none.
+ */
+- (BOOL)drawInContext:(CGContextRef)context;
+
+/**
+ * Rasterizes `bounds`, in the context's user space, at the context's CTM and
+ * composites the result. `renderer` draws into a bitmap whose CTM is the
+ * context's one translated by `offset`. Returns NO when the bounds are empty
+ * or too large to cache, nothing is drawn then.
+ */
+- (BOOL)rasterizeBounds:(CGRect)bounds
+              inContext:(CGContextRef)context
+               renderer:(void (^)(CGContextRef bitmap, CGAffineTransform offset))renderer;
+
+- (void)removeAllEntries;
+
+@end
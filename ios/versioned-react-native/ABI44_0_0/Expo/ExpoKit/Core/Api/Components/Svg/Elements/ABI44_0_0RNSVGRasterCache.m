@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "ABI44_0_0RNSVGRasterCache.h"
+
+#import <os/lock.h>
+
+// Upper bound of a cached bitmap size, in device pixels.
+static const CGFloat kRNSVGRasterCacheMaxPixels = 2048 * 2048;
+
+// Upper bound of the memory held by the bitmaps of all caches, in bytes.
+static const size_t kRNSVGRasterCacheMaxBytes = 64 * 1024 * 1024;
+
+@class ABI44_0_0RNSVGRasterCache;
+
+@interface ABI44_0_0RNSVGRasterCacheEntry : NSObject
+
+@property (nonatomic, assign) CGImageRef image;
+@property (nonatomic, assign) CGRect rect;
+@property (nonatomic, assign) CGAffineTransform transform;
+@property (nonatomic, assign) size_t bytes;
+@property (nonatomic, weak) ABI44_0_0RNSVGRasterCache *cache;
+
+@end
+
+@implementation ABI44_0_0RNSVGRasterCacheEntry
+
+- (void)dealloc
+{
+    CGImageRelease(_image);
+}
+
+@end
+
+/**
+ * Entries of all caches, most recently used last, and the bytes they hold.
+ * Guarded by the lock, which also guards the entries of every cache, as
+ * entries are evicted from any cache once the budget is exceeded. Snapshots
+ * render off the main thread.
+ */
+static os_unfair_lock sRasterCacheLock = OS_UNFAIR_LOCK_INIT;
+static NSMutableArray<ABI44_0_0RNSVGRasterCacheEntry *> *sRasterCacheEntries;
+static size_t sRasterCacheBytes;
+
+// Number of bitmaps being rendered by `rasterizeBounds:` on this thread.
+static __thread NSUInteger sRasterizingDepth;
+
+@implementation ABI44_0_0RNSVGRasterCache
+{
+    // Most recently used last.
+    NSMutableArray<ABI44_0_0RNSVGRasterCacheEntry *> *_entries;
+}
+
++ (void)initialize
+{
+    if (self == [ABI44_0_0RNSVGRasterCache class]) {
+        sRasterCacheEntries = [NSMutableArray array];
+    }
+}
+
++ (BOOL)isRasterizing
+{
+    return sRasterizingDepth > 0;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+    if (self = [super init]) {
+        _capacity = MAX(capacity, (NSUInteger)1);
+        _entries = [NSMutableArray arrayWithCapacity:_capacity];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self removeAllEntries];
+}
+
+- (NSUInteger)count
+{
+    os_unfair_lock_lock(&sRasterCacheLock);
+    NSUInteger count = _entries.count;
+    os_unfair_lock_unlock(&sRasterCacheLock);
+    return count;
+}
+
+- (BOOL)drawInContext:(CGContextRef)context
+{
+    CGAffineTransform current = CGContextGetCTM(context);
+    ABI44_0_0RNSVGRasterCacheEntry *match = nil;
+    os_unfair_lock_lock(&sRasterCacheLock);
+    for (ABI44_0_0RNSVGRasterCacheEntry *entry in [_entries reverseObjectEnumerator]) {
+        if ([self isTransform:current compatibleWith:entry.transform]) {
+            match = entry;
+            [self touchEntryLocked:entry];
+            break;
+        }
+    }
+    os_unfair_lock_unlock(&sRasterCacheLock);
+
+    // The entry keeps its image alive even if it is evicted meanwhile.
+    if (!match) {
+        return NO;
+    }
+    [self drawEntry:match inContext:context];
+    return YES;
+}
+
+- (BOOL)rasterizeBounds:(CGRect)bounds
+              inContext:(CGContextRef)context
+               renderer:(void (^)(CGContextRef bitmap, CGAffineTransform offset))renderer
+{
+    if (CGRectIsEmpty(bounds) || CGRectIsInfinite(bounds)) {
+        return NO;
+    }
+
+    // Leave room for antialiasing along the edges.
+    CGAffineTransform current = CGContextGetCTM(context);
+    CGRect deviceRect = CGRectIntegral(CGRectInset(CGRectApplyAffineTransform(bounds, current), -1, -1));
+    size_t width = (size_t)CGRectGetWidth(deviceRect);
+    size_t height = (size_t)CGRectGetHeight(deviceRect);
+    if (width == 0 || height == 0 || (CGFloat)width * height > kRNSVGRasterCacheMaxPixels) {
+        return NO;
+    }
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef bitmap = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+    CGColorSpaceRelease(colorSpace);
+    if (!bitmap) {
+        return NO;
+    }
+
+    CGAffineTransform offset = CGAffineTransformMakeTranslation(-CGRectGetMinX(deviceRect), -CGRectGetMinY(deviceRect));
+    CGContextConcatCTM(bitmap, CGAffineTransformConcat(current, offset));
+    sRasterizingDepth++;
+    renderer(bitmap, offset);
+    sRasterizingDepth--;
+    CGImageRef image = CGBitmapContextCreateImage(bitmap);
+    CGContextRelease(bitmap);
+    if (!image) {
+        return NO;
+    }
+
+    ABI44_0_0RNSVGRasterCacheEntry *entry = [ABI44_0_0RNSVGRasterCacheEntry new];
+    entry.image = image;
+    entry.rect = deviceRect;
+    entry.transform = current;
+    entry.bytes = CGImageGetBytesPerRow(image) * CGImageGetHeight(image);
+    entry.cache = self;
+    [self addEntry:entry];
+
+    [self drawEntry:entry inContext:context];
+    return YES;
+}
+
+- (void)removeAllEntries
+{
+    os_unfair_lock_lock(&sRasterCacheLock);
+    for (ABI44_0_0RNSVGRasterCacheEntry *entry in _entries) {
+        [sRasterCacheEntries removeObjectIdenticalTo:entry];
+        sRasterCacheBytes -= entry.bytes;
+    }
+    [_entries removeAllObjects];
+    os_unfair_lock_unlock(&sRasterCacheLock);
+}
+
+/**
+ * Adds the entry as the most recently used one, evicting the least recently
+ * used entry of this cache once it is full and those of all caches once they
+ * hold more than `kRNSVGRasterCacheMaxBytes`. The new entry is never evicted.
+ */
+- (void)addEntry:(ABI44_0_0RNSVGRasterCacheEntry *)entry
+{
+    os_unfair_lock_lock(&sRasterCacheLock);
+    if (_entries.count >= _capacity) {
+        [self removeEntryLocked:_entries.firstObject];
+    }
+    [_entries addObject:entry];
+    [sRasterCacheEntries addObject:entry];
+    sRasterCacheBytes += entry.bytes;
+
+    while (sRasterCacheBytes > kRNSVGRasterCacheMaxBytes && sRasterCacheEntries.firstObject != entry) {
+        ABI44_0_0RNSVGRasterCacheEntry *evicted = sRasterCacheEntries.firstObject;
+        ABI44_0_0RNSVGRasterCache *cache = evicted.cache;
+        if (cache) {
+            [cache removeEntryLocked:evicted];
+        } else {
+            [sRasterCacheEntries removeObjectAtIndex:0];
+            sRasterCacheBytes -= evicted.bytes;
+        }
+    }
+    os_unfair_lock_unlock(&sRasterCacheLock);
+}
+
+- (void)removeEntryLocked:(ABI44_0_0RNSVGRasterCacheEntry *)entry
+{
+    [_entries removeObjectIdenticalTo:entry];
+    [sRasterCacheEntries removeObjectIdenticalTo:entry];
+    sRasterCacheBytes -= entry.bytes;
+}
+
+- (void)touchEntryLocked:(ABI44_0_0RNSVGRasterCacheEntry *)entry
+{
+    if (entry != _entries.lastObject) {
+        [_entries removeObjectIdenticalTo:entry];
+        [_entries addObject:entry];
+    }
+    if (entry != sRasterCacheEntries.lastObject) {
+        [sRasterCacheEntries removeObjectIdenticalTo:entry];
+        [sRasterCacheEntries addObject:entry];
+    }
+}
+
+- (BOOL)isTransform:(CGAffineTransform)transform compatibleWith:(CGAffineTransform)cached
+{
+    if (transform.a != cached.a || transform.b != cached.b || transform.c != cached.c || transform.d != cached.d) {
+        return NO;
+    }
+    CGFloat dx = transform.tx - cached.tx;
+    CGFloat dy = transform.ty - cached.ty;
+    return fabs(dx - round(dx)) < 1e-3 && fabs(dy - round(dy)) < 1e-3;
+}
+
+- (void)drawEntry:(ABI44_0_0RNSVGRasterCacheEntry *)entry inContext:(CGContextRef)context
+{
+    // Compatible transforms only differ by whole device pixels.
+    CGAffineTransform current = CGContextGetCTM(context);
+    CGRect target = CGRectOffset(entry.rect,
+                                 round(current.tx - entry.transform.tx),
+                                 round(current.ty - entry.transform.ty));
+    CGContextSaveGState(context);
+    CGContextConcatCTM(context, CGAffineTransformInvert(current));
+    CGContextSetInterpolationQuality(context, kCGInterpolationNone);
+    CGContextDrawImage(context, target, entry.image);
+    CGContextRestoreGState(context);
+}
+
+@end
@@ -0,0 +1,26 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+/**
+ * Rasterizes a recorded display list (a single page PDF) into a PNG without
+ * allocating the whole bitmap: the image is rendered in horizontal strips
+ * while the encoder consumes it. Not thread-safe, but it does not touch any
+ * view, so it can be used from any queue.
+ */
+@interface ABI44_0_0RNSVGSnapshotRenderer : NSObject
+
+- (instancetype)initWithDisplayList:(NSData *)displayList size:(CGSize)size scale:(CGFloat)scale;
+
+- (NSData *)PNGData;
+
+- (BOOL)writePNGToURL:(NSURL *)url;
+
+@end
@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "ABI44_0_0RNSVGSnapshotRenderer.h"
+#import <ImageIO/ImageIO.h>
+
+// Upper bound of the memory used by one strip.
+static const size_t kRNSVGSnapshotStripBytes = 4 * 1024 * 1024;
+
+static size_t ABI44_0_0RNSVGSnapshotGetBytes(void *info, void *buffer, size_t count);
+static off_t ABI44_0_0RNSVGSnapshotSkipForward(void *info, off_t count);
+static void ABI44_0_0RNSVGSnapshotRewind(void *info);
+static void ABI44_0_0RNSVGSnapshotReleaseInfo(void *info);
+
+@implementation ABI44_0_0RNSVGSnapshotRenderer
+{
+    CGPDFDocumentRef _document;
+    CGPDFPageRef _page;
+    CGFloat _scale;
+    size_t _width;
+    size_t _height;
+    size_t _bytesPerRow;
+    size_t _stripRows;
+    CGContextRef _strip;
+    size_t _stripFirstRow;
+    BOOL _stripRendered;
+    size_t _offset;
+}
+
+- (instancetype)initWithDisplayList:(NSData *)displayList size:(CGSize)size scale:(CGFloat)scale
+{
+    if (self = [super init]) {
+        CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)displayList);
+        _document = CGPDFDocumentCreateWithProvider(provider);
+        CGDataProviderRelease(provider);
+        _page = _document ? CGPDFDocumentGetPage(_document, 1) : NULL;
+        _scale = scale;
+        _width = (size_t)ceil(size.width * scale);
+        _height = (size_t)ceil(size.height * scale);
+        _bytesPerRow = _width * 4;
+        _stripRows = _bytesPerRow ? MAX((size_t)1, MIN(_height, kRNSVGSnapshotStripBytes / _bytesPerRow)) : 0;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    CGContextRelease(_strip);
+    CGPDFDocumentRelease(_document);
+}
+
+#pragma mark - Encoding
+
+- (NSData *)PNGData
+{
+    NSMutableData *data = [NSMutableData data];
+    CGImageDestinationRef destination = CGImageDestinationCreateWithData((__bridge CFMutableDataRef)data, CFSTR("public.png"), 1, NULL);
+    BOOL written = [self writePNGToDestination:destination];
+    if (destination) {
+        CFRelease(destination);
+    }
+    return written ? data : nil;
+}
+
+- (BOOL)writePNGToURL:(NSURL *)url
+{
+    CGImageDestinationRef destination = CGImageDestinationCreateWithURL((__bridge CFURLRef)url, CFSTR("public.png"), 1, NULL);
+    BOOL written = [self writePNGToDestination:destination];
+    if (destination) {
+        CFRelease(destination);
+    }
+    return written;
+}
+
+- (BOOL)writePNGToDestination:(CGImageDestinationRef)destination
+{
+    if (!destination || !_page || !_width || !_height) {
+        return NO;
+    }
+
+    // The provider pulls rows from the strips on demand, so the encoder never
+    // sees more than one strip of decoded pixels at a time.
+    CGDataProviderSequentialCallbacks callbacks = {
+        .version = 0,
+        .getBytes = ABI44_0_0RNSVGSnapshotGetBytes,
+        .skipForward = ABI44_0_0RNSVGSnapshotSkipForward,
+        .rewind = ABI44_0_0RNSVGSnapshotRewind,
+        .releaseInfo = ABI44_0_0RNSVGSnapshotReleaseInfo,
+    };
+    CGDataProviderRef provider = CGDataProviderCreateSequential((__bridge_retained void *)self, &callbacks);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef image = CGImageCreate(_width, _height, 8, 32, _bytesPerRow, colorSpace,
+                                     kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host,
+                                     provider, NULL, false, kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+    if (!image) {
+        return NO;
+    }
+
+    CGImageDestinationAddImage(destination, image, NULL);
+    BOOL finalized = CGImageDestinationFinalize(destination);
+    CGImageRelease(image);
+    return finalized;
+}
+
+#pragma mark - Strips
+
+- (BOOL)renderStripAtRow:(size_t)firstRow
+{
+    if (!_strip) {
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        _strip = CGBitmapContextCreate(NULL, _width, _stripRows, 8, _bytesPerRow, colorSpace,
+                                       kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+        CGColorSpaceRelease(colorSpace);
+        if (!_strip) {
+            return NO;
+        }
+    }
+
+    // The last strip may be partial, its rows are the top ones of the context.
+    size_t rows = MIN(_stripRows, _height - firstRow);
+    CGRect stripRect = CGRectMake(0, (CGFloat)(_stripRows - rows), _width, rows);
+    CGContextClearRect(_strip, CGRectMake(0, 0, _width, _stripRows));
+    CGContextSaveGState(_strip);
+    // Content outside of the strip is culled instead of being rasterized for
+    // every strip.
+    CGContextClipToRect(_strip, stripRect);
+    // Bitmap rows are stored top down while the page is drawn bottom up, move
+    // the page so that the strip's rows land at the top of the context. The
+    // offset is positive for the last strip, compute it in floating point.
+    CGContextTranslateCTM(_strip, 0, (CGFloat)firstRow + (CGFloat)_stripRows - (CGFloat)_height);
+    CGContextScaleCTM(_strip, _scale, _scale);
+    CGContextDrawPDFPage(_strip, _page);
+    CGContextRestoreGState(_strip);
+
+    _stripFirstRow = firstRow;
+    _stripRendered = YES;
+    return YES;
+}
+
+- (size_t)getBytes:(void *)buffer count:(size_t)count
+{
+    size_t total = _bytesPerRow * _height;
+    size_t written = 0;
+    while (written < count && _offset < total) {
+        size_t row = _offset / _bytesPerRow;
+        if (!_stripRendered || row < _stripFirstRow || row >= _stripFirstRow + _stripRows) {
+            if (![self renderStripAtRow:row - row % _stripRows]) {
+                break;
+            }
+        }
+        size_t stripStart = _stripFirstRow * _bytesPerRow;
+        size_t stripEnd = MIN(stripStart + _stripRows * _bytesPerRow, total);
+        size_t length = MIN(count - written, stripEnd - _offset);
+        const uint8_t *data = CGBitmapContextGetData(_strip);
+        memcpy((uint8_t *)buffer + written, data + (_offset - stripStart), length);
+        written += length;
+        _offset += length;
+    }
+    return written;
+}
+
+- (off_t)skipForward:(off_t)count
+{
+    size_t total = _bytesPerRow * _height;
+    size_t skipped = MIN((size_t)MAX(count, 0), total - _offset);
+    _offset += skipped;
+    return (off_t)skipped;
+}
+
+- (void)rewind
+{
+    _offset = 0;
+}
+
+static size_t ABI44_0_0RNSVGSnapshotGetBytes(void *info, void *buffer, size_t count)
+{
+    return [(__bridge ABI44_0_0RNSVGSnapshotRenderer *)info getBytes:buffer count:count];
+}
+
+static off_t ABI44_0_0RNSVGSnapshotSkipForward(void *info, off_t count)
+{
+    return [(__bridge ABI44_0_0RNSVGSnapshotRenderer *)info skipForward:count];
+}
+
+static void ABI44_0_0RNSVGSnapshotRewind(void *info)
+{
+    [(__bridge ABI44_0_0RNSVGSnapshotRenderer *)info rewind];
+}
+
+static void ABI44_0_0RNSVGSnapshotReleaseInfo(void *info)
+{
+    CFBridgingRelease(info);
+}
+
+@end
@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+@class ABI44_0_0RNSVGNode;
+
+/**
+ * Bounding volume hierarchy over the children of a container, in the
+ * container's coordinate space, used to skip hit-testing children that cannot
+ * contain the point. Children are updated one at a time as they render, only
+ * children whose hit test never succeeds outside of their bounds are indexed.
+ */
+@interface ABI44_0_0RNSVGSpatialIndex : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * Whether a container with these children is large enough to index.
+ */
++ (BOOL)shouldIndexChildren:(NSArray *)children;
+
+/**
+ * Indexes the current bounds of the node, or removes it when they cannot be
+ * relied on.
+ */
+- (void)updateNode:(ABI44_0_0RNSVGNode *)node;
+
+- (void)removeNode:(ABI44_0_0RNSVGNode *)node;
+
+- (BOOL)containsNode:(ABI44_0_0RNSVGNode *)node;
+
+/**
+ * Indexed nodes whose bounds contain the point, other indexed nodes can be
+ * skipped. Nodes that are not indexed always have to be tested.
+ */
+- (NSSet<ABI44_0_0RNSVGNode *> *)nodesAtPoint:(CGPoint)point;
+
+@end
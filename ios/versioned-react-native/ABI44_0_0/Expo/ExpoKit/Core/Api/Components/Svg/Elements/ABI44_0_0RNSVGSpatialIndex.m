@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) 2015-present, Horcrux.
+ * All rights reserved.
+ *
+ * This source code is licensed under the MIT-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "ABI44_0_0RNSVGSpatialIndex.h"
+#import "ABI44_0_0RNSVGGroup.h"
+#import "ABI44_0_0RNSVGImage.h"
+#import "ABI44_0_0RNSVGUse.h"
+
+static const NSInteger kRNSVGSpatialIndexNull = -1;
+// Below this many children, testing each of them is cheaper than the index.
+static const NSUInteger kRNSVGSpatialIndexMinChildren = 16;
+// Leaves are enlarged by this fraction of their size, so that small moves do
+// not restructure the tree.
+static const CGFloat kRNSVGSpatialIndexMargin = 0.1;
+
+typedef struct {
+    CGRect box;
+    // Unretained, nodes are removed before they leave their container.
+    const void *object;
+    // Next free node while the node is unused.
+    NSInteger parent;
+    NSInteger left;
+    NSInteger right;
+    // 0 for leaves, -1 for free nodes.
+    NSInteger height;
+} ABI44_0_0RNSVGSpatialIndexNode;
+
+static CGFloat ABI44_0_0RNSVGSpatialIndexPerimeter(CGRect rect)
+{
+    return 2 * (CGRectGetWidth(rect) + CGRectGetHeight(rect));
+}
+
+@implementation ABI44_0_0RNSVGSpatialIndex
+{
+    ABI44_0_0RNSVGSpatialIndexNode *_nodes;
+    NSInteger *_stack;
+    NSInteger _capacity;
+    NSInteger _root;
+    NSInteger _freeList;
+    // Node pointer to leaf index.
+    CFMutableDictionaryRef _leaves;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _root = kRNSVGSpatialIndexNull;
+        _freeList = kRNSVGSpatialIndexNull;
+        _leaves = CFDictionaryCreateMutable(NULL, 0, NULL, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_nodes);
+    free(_stack);
+    CFRelease(_leaves);
+}
+
+- (NSUInteger)count
+{
+    return (NSUInteger)CFDictionaryGetCount(_leaves);
+}
+
+#pragma mark - Nodes
+
++ (BOOL)shouldIndexChildren:(NSArray *)children
+{
+    return children.count >= kRNSVGSpatialIndexMinChildren;
+}
+
++ (BOOL)canIndexNode:(ABI44_0_0RNSVGNode *)node
+{
+    // Groups and renderables reject points outside of their path bounds before
+    // anything else. Subclasses of groups (text, definitions, foreign objects)
+    // and nodes hit-tested through other nodes do not.
+    if ([node isKindOfClass:[ABI44_0_0RNSVGGroup class]]) {
+        return [node class] == [ABI44_0_0RNSVGGroup class];
+    }
+    return [node isKindOfClass:[ABI44_0_0RNSVGRenderable class]] &&
+        ![node isKindOfClass:[ABI44_0_0RNSVGUse class]] &&
+        ![node isKindOfClass:[ABI44_0_0RNSVGImage class]];
+}
+
+- (void)updateNode:(ABI44_0_0RNSVGNode *)node
+{
+    CGRect bounds = node.pathBounds;
+    if (![ABI44_0_0RNSVGSpatialIndex canIndexNode:node] || CGRectIsEmpty(bounds) || CGRectIsInfinite(bounds)) {
+        [self removeNode:node];
+        return;
+    }
+
+    // Hit tests map the point through invmatrix, then invTransform.
+    CGAffineTransform transform = CGAffineTransformConcat(node.transforms, node.matrix);
+    bounds = CGRectApplyAffineTransform(bounds, transform);
+    if (isnan(CGRectGetMinX(bounds)) || isnan(CGRectGetMinY(bounds))) {
+        [self removeNode:node];
+        return;
+    }
+
+    const void *leaf;
+    if (CFDictionaryGetValueIfPresent(_leaves, (__bridge const void *)node, &leaf)) {
+        NSInteger index = (NSInteger)(intptr_t)leaf;
+        if (CGRectContainsRect(_nodes[index].box, bounds)) {
+            return;
+        }
+        [self removeLeaf:index];
+        [self insertLeaf:index bounds:bounds];
+        return;
+    }
+
+    NSInteger index = [self allocateNode];
+    _nodes[index].object = (__bridge const void *)node;
+    _nodes[index].height = 0;
+    [self insertLeaf:index bounds:bounds];
+    CFDictionarySetValue(_leaves, (__bridge const void *)node, (const void *)(intptr_t)index);
+}
+
+- (void)removeNode:(ABI44_0_0RNSVGNode *)node
+{
+    const void *leaf;
+    if (!CFDictionaryGetValueIfPresent(_leaves, (__bridge const void *)node, &leaf)) {
+        return;
+    }
+    NSInteger index = (NSInteger)(intptr_t)leaf;
+    [self removeLeaf:index];
+    [self freeNode:index];
+    CFDictionaryRemoveValue(_leaves, (__bridge const void *)node);
+}
+
+- (BOOL)containsNode:(ABI44_0_0RNSVGNode *)node
+{
+    return CFDictionaryContainsKey(_leaves, (__bridge const void *)node);
+}
+
+- (NSSet<ABI44_0_0RNSVGNode *> *)nodesAtPoint:(CGPoint)point
+{
+    NSMutableSet<ABI44_0_0RNSVGNode *> *nodes = [NSMutableSet set];
+    if (_root == kRNSVGSpatialIndexNull) {
+        return nodes;
+    }
+
+    NSInteger count = 0;
+    _stack[count++] = _root;
+    while (count > 0) {
+        NSInteger index = _stack[--count];
+        if (!CGRectContainsPoint(_nodes[index].box, point)) {
+            continue;
+        }
+        if (_nodes[index].height == 0) {
+            [nodes addObject:(__bridge ABI44_0_0RNSVGNode *)_nodes[index].object];
+        } else {
+            _stack[count++] = _nodes[index].left;
+            _stack[count++] = _nodes[index].right;
+        }
+    }
+    return nodes;
+}
+
+#pragma mark - Tree
+
+- (NSInteger)allocateNode
+{
+    if (_freeList == kRNSVGSpatialIndexNull) {
+        NSInteger capacity = MAX(_capacity * 2, (NSInteger)16);
+        _nodes = realloc(_nodes, capacity * sizeof(ABI44_0_0RNSVGSpatialIndexNode));
+        // Every node may be on the query stack at most once.
+        _stack = realloc(_stack, capacity * sizeof(NSInteger));
+        for (NSInteger i = _capacity; i < capacity; i++) {
+            _nodes[i].parent = i + 1 < capacity ? i + 1 : kRNSVGSpatialIndexNull;
+            _nodes[i].height = -1;
+        }
+        _freeList = _capacity;
+        _capacity = capacity;
+    }
+
+    NSInteger index = _freeList;
+    _freeList = _nodes[index].parent;
+    _nodes[index].box = CGRectNull;
+    _nodes[index].object = NULL;
+    _nodes[index].parent = kRNSVGSpatialIndexNull;
+    _nodes[index].left = kRNSVGSpatialIndexNull;
+    _nodes[index].right = kRNSVGSpatialIndexNull;
+    _nodes[index].height = 0;
+    return index;
+}
+
+- (void)freeNode:(NSInteger)index
+{
+    _nodes[index].parent = _freeList;
+    _nodes[index].height = -1;
+    _nodes[index].object = NULL;
+    _freeList = index;
+}
+
+- (void)insertLeaf:(NSInteger)leaf bounds:(CGRect)bounds
+{
+    CGFloat margin = kRNSVGSpatialIndexMargin * MAX(CGRectGetWidth(bounds), CGRectGetHeight(bounds));
+    CGRect box = CGRectInset(bounds, -MAX(margin, 1), -MAX(margin, 1));
+    _nodes[leaf].box = box;
+
+    if (_root == kRNSVGSpatialIndexNull) {
+        _root = leaf;
+        _nodes[leaf].parent = kRNSVGSpatialIndexNull;
+        return;
+    }
+
+    // Find the sibling whose enlargement costs the least, by perimeter.
+    NSInteger index = _root;
+    while (_nodes[index].height > 0) {
+        NSInteger left = _nodes[index].left;
+        NSInteger right = _nodes[index].right;
+
+        CGFloat perimeter = ABI44_0_0RNSVGSpatialIndexPerimeter(_nodes[index].box);
+        CGFloat combined = ABI44_0_0RNSVGSpatialIndexPerimeter(CGRectUnion(_nodes[index].box, box));
+        CGFloat cost = 2 * combined;
+        CGFloat inheritance = 2 * (combined - perimeter);
+        CGFloat leftCost = [self costOfInserting:box below:left] + inheritance;
+        CGFloat rightCost = [self costOfInserting:box below:right] + inheritance;
+        if (cost < leftCost && cost < rightCost) {
+            break;
+        }
+        index = leftCost < rightCost ? left : right;
+    }
+
+    NSInteger sibling = index;
+    NSInteger oldParent = _nodes[sibling].parent;
+    NSInteger newParent = [self allocateNode];
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].box = CGRectUnion(box, _nodes[sibling].box);
+    _nodes[newParent].height = _nodes[sibling].height + 1;
+    _nodes[newParent].left = sibling;
+    _nodes[newParent].right = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    if (oldParent == kRNSVGSpatialIndexNull) {
+        _root = newParent;
+    } else if (_nodes[oldParent].left == sibling) {
+        _nodes[oldParent].left = newParent;
+    } else {
+        _nodes[oldParent].right = newParent;
+    }
+
+    [self refitFrom:newParent];
+}
+
+- (CGFloat)costOfInserting:(CGRect)box below:(NSInteger)index
+{
+    CGFloat combined = ABI44_0_0RNSVGSpatialIndexPerimeter(CGRectUnion(box, _nodes[index].box));
+    if (_nodes[index].height == 0) {
+        return combined;
+    }
+    return combined - ABI44_0_0RNSVGSpatialIndexPerimeter(_nodes[index].box);
+}
+
+- (void)removeLeaf:(NSInteger)leaf
+{
+    if (leaf == _root) {
+        _root = kRNSVGSpatialIndexNull;
+        return;
+    }
+
+    NSInteger parent = _nodes[leaf].parent;
+    NSInteger grandParent = _nodes[parent].parent;
+    NSInteger sibling = _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+
+    if (grandParent == kRNSVGSpatialIndexNull) {
+        _root = sibling;
+        _nodes[sibling].parent = kRNSVGSpatialIndexNull;
+        [self freeNode:parent];
+        return;
+    }
+
+    if (_nodes[grandParent].left == parent) {
+        _nodes[grandParent].left = sibling;
+    } else {
+        _nodes[grandParent].right = sibling;
+    }
+    _nodes[sibling].parent = grandParent;
+    [self freeNode:parent];
+    [self refitFrom:grandParent];
+}
+
+- (void)refitFrom:(NSInteger)index
+{
+    while (index != kRNSVGSpatialIndexNull) {
+        index = [self balance:index];
+        NSInteger left = _nodes[index].left;
+        NSInteger right = _nodes[index].right;
+        _nodes[index].height = 1 + MAX(_nodes[left].height, _nodes[right].height);
+        _nodes[index].box = CGRectUnion(_nodes[left].box, _nodes[right].box);
+        index = _nodes[index].parent;
+    }
+}
+
+/**
+ * Rotates the taller child of `a` up when the heights of its subtrees differ by
+ * more than one. Returns the index of the new root of the subtree.
+ */
+- (NSInteger)balance:(NSInteger)a
+{
+    if (_nodes[a].height < 2) {
+        return a;
+    }
+
+    NSInteger b = _nodes[a].left;
+    NSInteger c = _nodes[a].right;
+    NSInteger difference = _nodes[c].height - _nodes[b].height;
+    if (difference > 1) {
+        [self rotate:c upOver:a keeping:b isRight:YES];
+        return c;
+    }
+    if (difference < -1) {
+        [self rotate:b upOver:a keeping:c isRight:NO];
+        return b;
+    }
+    return a;
+}
+
+/**
+ * Makes `child` the parent of `a`. `a` keeps `other` and gets the shorter
+ * subtree of `child`, `child` keeps the taller one.
+ */
+- (void)rotate:(NSInteger)child upOver:(NSInteger)a keeping:(NSInteger)other isRight:(BOOL)isRight
+{
+    NSInteger f = _nodes[child].left;
+    NSInteger g = _nodes[child].right;
+
+    _nodes[child].left = a;
+    _nodes[child].parent = _nodes[a].parent;
+    _nodes[a].parent = child;
+
+    NSInteger parent = _nodes[child].parent;
+    if (parent == kRNSVGSpatialIndexNull) {
+        _root = child;
+    } else if (_nodes[parent].left == a) {
+        _nodes[parent].left = child;
+    } else {
+        _nodes[parent].right = child;
+    }
+
+    NSInteger taller = _nodes[f].height > _nodes[g].height ? f : g;
+    NSInteger shorter = taller == f ? g : f;
+    _nodes[child].right = taller;
+    if (isRight) {
+        _nodes[a].right = shorter;
+    } else {
+        _nodes[a].left = shorter;
+    }
+    _nodes[shorter].parent = a;
+
+    _nodes[a].box = CGRectUnion(_nodes[other].box, _nodes[shorter].box);
+    _nodes[a].height = 1 + MAX(_nodes[other].height, _nodes[shorter].height);
+    _nodes[child].box = CGRectUnion(_nodes[a].box, _nodes[taller].box);
+    _nodes[child].height = 1 + MAX(_nodes[a].height, _nodes[taller].height);
+}
+
+@end
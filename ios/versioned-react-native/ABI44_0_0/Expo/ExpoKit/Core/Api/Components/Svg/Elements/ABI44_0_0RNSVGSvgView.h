@@ -56,8 +56,28 @@
 
 - (NSString *)getDataURL;
 
+/**
+ * Renders the bounds at a scale of 1, on the main thread. The scene is
+ * recorded into a display list and rasterized in strips while it is encoded,
+ * so the full size bitmap is never allocated.
+ */
 - (NSString *)getDataURLwithBounds:(CGRect)bounds;
 
+/**
+ * Asynchronous variants of getDataURLwithBounds: at any scale, 0 being the
+ * screen scale. The display list is recorded on the calling thread, which has
+ * to be the main thread, and rasterized and encoded on a background queue.
+ * Completions are called on that queue, with nil or NO when the snapshot
+ * could not be rendered.
+ *
+ * Vector content is rendered sharp at any scale. Masks are rendered to
+ * bitmaps at the screen scale and images at their own resolution, so they
+ * lose detail at higher scales.
+ */
+- (void)getDataURLwithBounds:(CGRect)bounds scale:(CGFloat)scale completion:(void (^)(NSString *base64))completion;
+
+- (void)writeSnapshotWithBounds:(CGRect)bounds scale:(CGFloat)scale toURL:(NSURL *)url completion:(void (^)(BOOL success))completion;
+
 - (CGRect)getContextBounds;
 
 - (void)drawRect:(CGRect)rect;
@@ -9,6 +9,8 @@
 #import "ABI44_0_0RNSVGSvgView.h"
 #import "ABI44_0_0RNSVGViewBox.h"
 #import "ABI44_0_0RNSVGNode.h"
+#import "ABI44_0_0RNSVGSnapshotRenderer.h"
+#import "ABI44_0_0RNSVGSpatialIndex.h"
 #import <ABI44_0_0React/ABI44_0_0RCTLog.h>
 
 @implementation ABI44_0_0RNSVGSvgView
@@ -19,6 +21,7 @@
     NSMutableDictionary<NSString *, ABI44_0_0RNSVGNode *> *_markers;
     NSMutableDictionary<NSString *, ABI44_0_0RNSVGNode *> *_masks;
     CGAffineTransform _invviewBoxTransform;
+    ABI44_0_0RNSVGSpatialIndex *_hitTestIndex;
     bool rendered;
 }
 
@@ -197,6 +200,7 @@
             ABI44_0_0RNSVGNode *svg = (ABI44_0_0RNSVGNode *)node;
             [svg renderTo:context
                      rect:rect];
+            [self updateHitTestIndexForNode:svg];
         } else {
             [node drawRect:rect];
         }
@@ -236,6 +240,7 @@
     if (self.align) {
         transformed = CGPointApplyAffineTransform(transformed, _invviewBoxTransform);
     }
+    NSSet<ABI44_0_0RNSVGNode *> *candidates = _hitTestIndex.count ? [_hitTestIndex nodesAtPoint:transformed] : nil;
     for (ABI44_0_0RNSVGNode *node in [self.subviews reverseObjectEnumerator]) {
         if (![node isKindOfClass:[ABI44_0_0RNSVGNode class]]) {
             continue;
@@ -244,6 +249,10 @@
         if (event) {
             node.active = NO;
         }
+        // Active nodes keep receiving the touch wherever it moves.
+        if (candidates && !node.active && ![candidates containsObject:node] && [_hitTestIndex containsNode:node]) {
+            continue;
+        }
 
         ABI44_0_0RNSVGPlatformView *hitChild = [node hitTest:transformed withEvent:event];
 
@@ -255,6 +264,23 @@
     return nil;
 }
 
+- (void)updateHitTestIndexForNode:(ABI44_0_0RNSVGNode *)node
+{
+    if (!_hitTestIndex) {
+        if (![ABI44_0_0RNSVGSpatialIndex shouldIndexChildren:self.subviews]) {
+            return;
+        }
+        _hitTestIndex = [ABI44_0_0RNSVGSpatialIndex new];
+    }
+    [_hitTestIndex updateNode:node];
+}
+
+- (void)willRemoveSubview:(ABI44_0_0RNSVGPlatformView *)subview
+{
+    [_hitTestIndex removeNode:(ABI44_0_0RNSVGNode *)subview];
+    [super willRemoveSubview:subview];
+}
+
 - (NSString *)getDataURL
 {
     UIGraphicsBeginImageContextWithOptions(_boundingBox.size, NO, 0);
@@ -270,15 +296,49 @@
 
 - (NSString *)getDataURLwithBounds:(CGRect)bounds
 {
-    UIGraphicsBeginImageContextWithOptions(bounds.size, NO, 1);
+    NSData *imageData = [[self snapshotRendererWithBounds:bounds scale:1] PNGData];
+    return [imageData base64EncodedStringWithOptions:NSDataBase64Encoding64CharacterLineLength];
+}
+
+- (void)getDataURLwithBounds:(CGRect)bounds scale:(CGFloat)scale completion:(void (^)(NSString *base64))completion
+{
+    ABI44_0_0RNSVGSnapshotRenderer *renderer = [self snapshotRendererWithBounds:bounds scale:scale];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSData *imageData = [renderer PNGData];
+        completion([imageData base64EncodedStringWithOptions:NSDataBase64Encoding64CharacterLineLength]);
+    });
+}
+
+- (void)writeSnapshotWithBounds:(CGRect)bounds scale:(CGFloat)scale toURL:(NSURL *)url completion:(void (^)(BOOL success))completion
+{
+    ABI44_0_0RNSVGSnapshotRenderer *renderer = [self snapshotRendererWithBounds:bounds scale:scale];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        completion([renderer writePNGToURL:url]);
+    });
+}
+
+- (ABI44_0_0RNSVGSnapshotRenderer *)snapshotRendererWithBounds:(CGRect)bounds scale:(CGFloat)scale
+{
+    if (scale <= 0) {
+        scale = [UIScreen mainScreen].scale;
+    }
+    CGSize size = CGSizeMake(bounds.size.width * scale, bounds.size.height * scale);
+
+    // Nodes are views and may only be read on the main thread, record their
+    // drawing as vector commands that can be replayed anywhere. The page is
+    // recorded at the output scale, so content rasterized while recording is
+    // at the output resolution.
+    NSMutableData *displayList = [NSMutableData data];
+    UIGraphicsBeginPDFContextToData(displayList, CGRectMake(0, 0, size.width, size.height), nil);
+    UIGraphicsBeginPDFPage();
+    CGContextScaleCTM(UIGraphicsGetCurrentContext(), scale, scale);
     [self clearChildCache];
     [self drawRect:bounds];
     [self clearChildCache];
     [self invalidate];
-    NSData *imageData = UIImagePNGRepresentation(UIGraphicsGetImageFromCurrentImageContext());
-    NSString *base64 = [imageData base64EncodedStringWithOptions:NSDataBase64Encoding64CharacterLineLength];
-    UIGraphicsEndImageContext();
-    return base64;
+    UIGraphicsEndPDFContext();
+
+    return [[ABI44_0_0RNSVGSnapshotRenderer alloc] initWithDisplayList:displayList size:size scale:1];
 }
 
 - (void)ABI44_0_0ReactSetInheritedBackgroundColor:(ABI44_0_0RNSVGColor *)inheritedBackgroundColor
@@ -10,6 +10,11 @@
 #import <ABI44_0_0React/ABI44_0_0RCTLog.h>
 
 @implementation ABI44_0_0RNSVGUse
+{
+    CGPathRef _templatePath;
+    CGPathRef _usePath;
+    CGAffineTransform _usePathTransform;
+}
 
 - (void)setHref:(NSString *)href
 {
@@ -138,7 +143,26 @@
         return nil;
     }
     CGPathRef path = [template getPath:context];
-    return CGPathCreateCopyByTransformingPath(path, &transform);
+    if (!path) {
+        return nil;
+    }
+
+    // Template paths are shared, so only the translated copy is kept per use
+    // until the template hands out another path or the offset changes.
+    if (path != _templatePath || !CGAffineTransformEqualToTransform(transform, _usePathTransform)) {
+        CGPathRelease(_templatePath);
+        CGPathRelease(_usePath);
+        _templatePath = CGPathRetain(path);
+        _usePath = CGPathCreateCopyByTransformingPath(path, &transform);
+        _usePathTransform = transform;
+    }
+    return _usePath;
+}
+
+- (void)dealloc
+{
+    CGPathRelease(_templatePath);
+    CGPathRelease(_usePath);
 }
 
 @end
@@ -9,12 +9,93 @@
 
 #include <ABI44_0_0React/ABI44_0_0renderer/debug/DebugStringConvertibleItem.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace ABI44_0_0facebook {
 namespace ABI44_0_0React {
 
 using Fragment = AttributedString::Fragment;
 using Fragments = AttributedString::Fragments;
 
+/*
+ * Same as `Fragment::operator==`, but compares the cheap fields first.
+ */
+static bool fragmentsEqual(Fragment const &lhs, Fragment const &rhs) {
+  return std::tie(
+             lhs.string,
+             lhs.parentShadowView.tag,
+             lhs.parentShadowView.layoutMetrics) ==
+      std::tie(
+             rhs.string,
+             rhs.parentShadowView.tag,
+             rhs.parentShadowView.layoutMetrics) &&
+      lhs.textAttributes == rhs.textAttributes;
+}
+
+/*
+ * Distance (in bytes) between two UTF-16 offsets stored in the string index.
+ * An offset conversion scans at most this many bytes.
+ */
+static constexpr int kUTF16CheckpointInterval = 64;
+
+static inline bool isCodePointStart(unsigned char byte) {
+  return (byte & 0xC0) != 0x80;
+}
+
+/*
+ * Returns the number of UTF-16 code units of a code point which starts with
+ * the given (leading) UTF-8 byte.
+ */
+static inline int utf16LengthOfCodePoint(unsigned char leadingByte) {
+  return leadingByte >= 0xF0 ? 2 : 1;
+}
+
+/*
+ * Returns true if both fragments are equal except for their strings.
+ */
+static bool fragmentsEqualExceptString(
+    Fragment const &lhs,
+    Fragment const &rhs) {
+  return std::tie(
+             lhs.parentShadowView.tag, lhs.parentShadowView.layoutMetrics) ==
+      std::tie(rhs.parentShadowView.tag, rhs.parentShadowView.layoutMetrics) &&
+      lhs.textAttributes == rhs.textAttributes;
+}
+
+/*
+ * Returns the range of `lhs` which has to be replaced to turn it into `rhs`
+ * (the part between the longest common prefix and suffix). The bounds are
+ * kept on code point boundaries.
+ */
+static AttributedString::Range changedRange(
+    std::string const &lhs,
+    std::string const &rhs) {
+  auto minSize = std::min(lhs.size(), rhs.size());
+
+  auto prefix = size_t{0};
+  while (prefix < minSize && lhs[prefix] == rhs[prefix]) {
+    prefix++;
+  }
+  while (prefix > 0 &&
+         ((prefix < lhs.size() && !isCodePointStart(lhs[prefix])) ||
+          (prefix < rhs.size() && !isCodePointStart(rhs[prefix])))) {
+    prefix--;
+  }
+
+  auto suffix = size_t{0};
+  while (suffix < minSize - prefix &&
+         lhs[lhs.size() - 1 - suffix] == rhs[rhs.size() - 1 - suffix]) {
+    suffix++;
+  }
+  while (suffix > 0 && !isCodePointStart(lhs[lhs.size() - suffix])) {
+    suffix--;
+  }
+
+  return AttributedString::Range{
+      (int)prefix, (int)(lhs.size() - prefix - suffix)};
+}
+
 #pragma mark - Fragment
 
 std::string Fragment::AttachmentCharacter() {
@@ -44,8 +125,54 @@ bool Fragment::operator!=(const Fragment &rhs) const {
 
 #pragma mark - AttributedString
 
+AttributedString::AttributedString(AttributedString const &other)
+    : Sealable(other),
+      DebugStringConvertible(other),
+      fragments_(other.fragments_),
+      hash_(other.hash_.load(std::memory_order_relaxed)),
+      stringIndex_(other.loadStringIndex()) {
+  hasStringIndex_.store(stringIndex_ != nullptr, std::memory_order_relaxed);
+}
+
+// Moved-from strings, like mutated ones, are exclusively owned, so their
+// index is taken over without the atomic accessors.
+AttributedString::AttributedString(AttributedString &&other) noexcept
+    : Sealable(std::move(other)),
+      DebugStringConvertible(std::move(other)),
+      fragments_(std::move(other.fragments_)),
+      hash_(other.hash_.load(std::memory_order_relaxed)),
+      stringIndex_(std::move(other.stringIndex_)) {
+  hasStringIndex_.store(stringIndex_ != nullptr, std::memory_order_relaxed);
+  other.hash_.store(0, std::memory_order_relaxed);
+  other.hasStringIndex_.store(false, std::memory_order_relaxed);
+}
+
+AttributedString &AttributedString::operator=(AttributedString const &other) {
+  Sealable::operator=(other);
+  fragments_ = other.fragments_;
+  hash_.store(
+      other.hash_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  stringIndex_ = other.loadStringIndex();
+  hasStringIndex_.store(stringIndex_ != nullptr, std::memory_order_relaxed);
+  return *this;
+}
+
+AttributedString &AttributedString::operator=(
+    AttributedString &&other) noexcept {
+  Sealable::operator=(std::move(other));
+  fragments_ = std::move(other.fragments_);
+  hash_.store(
+      other.hash_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  stringIndex_ = std::move(other.stringIndex_);
+  hasStringIndex_.store(stringIndex_ != nullptr, std::memory_order_relaxed);
+  other.hash_.store(0, std::memory_order_relaxed);
+  other.hasStringIndex_.store(false, std::memory_order_relaxed);
+  return *this;
+}
+
 void AttributedString::appendFragment(const Fragment &fragment) {
   ensureUnsealed();
+  invalidateMemoizedValues();
 
   if (fragment.string.empty()) {
     return;
@@ -56,6 +183,7 @@ void AttributedString::appendFragment(const Fragment &fragment) {
 
 void AttributedString::prependFragment(const Fragment &fragment) {
   ensureUnsealed();
+  invalidateMemoizedValues();
 
   if (fragment.string.empty()) {
     return;
@@ -64,9 +192,32 @@ void AttributedString::prependFragment(const Fragment &fragment) {
   fragments_.insert(fragments_.begin(), fragment);
 }
 
+void AttributedString::appendFragment(Fragment &&fragment) {
+  ensureUnsealed();
+  invalidateMemoizedValues();
+
+  if (fragment.string.empty()) {
+    return;
+  }
+
+  fragments_.push_back(std::move(fragment));
+}
+
+void AttributedString::prependFragment(Fragment &&fragment) {
+  ensureUnsealed();
+  invalidateMemoizedValues();
+
+  if (fragment.string.empty()) {
+    return;
+  }
+
+  fragments_.insert(fragments_.begin(), std::move(fragment));
+}
+
 void AttributedString::appendAttributedString(
     const AttributedString &attributedString) {
   ensureUnsealed();
+  invalidateMemoizedValues();
   fragments_.insert(
       fragments_.end(),
       attributedString.fragments_.begin(),
@@ -76,26 +227,114 @@ void AttributedString::appendAttributedString(
 void AttributedString::prependAttributedString(
     const AttributedString &attributedString) {
   ensureUnsealed();
+  invalidateMemoizedValues();
   fragments_.insert(
       fragments_.begin(),
       attributedString.fragments_.begin(),
       attributedString.fragments_.end());
 }
 
+void AttributedString::appendAttributedString(
+    AttributedString &&attributedString) {
+  ensureUnsealed();
+  invalidateMemoizedValues();
+  if (fragments_.empty()) {
+    fragments_ = std::move(attributedString.fragments_);
+  } else {
+    fragments_.insert(
+        fragments_.end(),
+        std::make_move_iterator(attributedString.fragments_.begin()),
+        std::make_move_iterator(attributedString.fragments_.end()));
+  }
+  attributedString.fragments_.clear();
+  attributedString.invalidateMemoizedValues();
+}
+
+void AttributedString::reserve(size_t capacity) {
+  fragments_.reserve(capacity);
+}
+
 Fragments const &AttributedString::getFragments() const {
   return fragments_;
 }
 
 Fragments &AttributedString::getFragments() {
+  invalidateMemoizedValues();
   return fragments_;
 }
 
 std::string AttributedString::getString() const {
-  auto string = std::string{};
-  for (const auto &fragment : fragments_) {
-    string += fragment.string;
+  return getCachedString();
+}
+
+std::string const &AttributedString::getCachedString() const {
+  return getStringIndex()->string;
+}
+
+int AttributedString::getUTF16Offset(int utf8Offset) const {
+  auto stringIndex = getStringIndex();
+  auto const &string = stringIndex->string;
+  utf8Offset = std::max(0, std::min(utf8Offset, (int)string.size()));
+
+  if (stringIndex->utf16Checkpoints.empty()) {
+    return utf8Offset;
   }
-  return string;
+
+  auto checkpoint = utf8Offset / kUTF16CheckpointInterval;
+  auto utf16Offset = stringIndex->utf16Checkpoints[checkpoint];
+  for (auto i = checkpoint * kUTF16CheckpointInterval; i < utf8Offset; i++) {
+    auto byte = (unsigned char)string[i];
+    if (isCodePointStart(byte)) {
+      utf16Offset += utf16LengthOfCodePoint(byte);
+    }
+  }
+  return utf16Offset;
+}
+
+int AttributedString::getUTF8Offset(int utf16Offset) const {
+  auto stringIndex = getStringIndex();
+  auto const &string = stringIndex->string;
+  utf16Offset = std::max(0, std::min(utf16Offset, stringIndex->utf16Length));
+
+  auto const &checkpoints = stringIndex->utf16Checkpoints;
+  if (checkpoints.empty()) {
+    return utf16Offset;
+  }
+
+  // The last checkpoint which is not past the requested offset.
+  auto checkpoint =
+      std::upper_bound(checkpoints.begin(), checkpoints.end(), utf16Offset) -
+      checkpoints.begin() - 1;
+  auto currentUTF16Offset = checkpoints[checkpoint];
+  auto utf8Offset = (int)checkpoint * kUTF16CheckpointInterval;
+  for (; utf8Offset < (int)string.size(); utf8Offset++) {
+    auto byte = (unsigned char)string[utf8Offset];
+    if (isCodePointStart(byte)) {
+      if (currentUTF16Offset >= utf16Offset) {
+        break;
+      }
+      currentUTF16Offset += utf16LengthOfCodePoint(byte);
+    }
+  }
+  return utf8Offset;
+}
+
+AttributedString::Range AttributedString::getUTF16Range(
+    Range const &utf8Range) const {
+  auto location = getUTF16Offset(utf8Range.location);
+  auto end = getUTF16Offset(utf8Range.location + utf8Range.length);
+  return Range{location, end - location};
+}
+
+AttributedString::Range AttributedString::getUTF8Range(
+    Range const &utf16Range) const {
+  auto location = getUTF8Offset(utf16Range.location);
+  auto end = getUTF8Offset(utf16Range.location + utf16Range.length);
+  return Range{location, end - location};
+}
+
+int AttributedString::getUTF16Length() const {
+  return getStringIndex()->utf16Length;
 }
 
 bool AttributedString::isEmpty() const {
@@ -118,14 +357,218 @@ bool AttributedString::compareTextAttributesWithoutFrame(
   return true;
 }
 
+AttributedString::Edits AttributedString::diff(
+    const AttributedString &rhs) const {
+  auto edits = Edits{};
+  if (this == &rhs) {
+    return edits;
+  }
+
+  auto const &oldFragments = fragments_;
+  auto const &newFragments = rhs.fragments_;
+  auto oldSize = oldFragments.size();
+  auto newSize = newFragments.size();
+  auto minSize = std::min(oldSize, newSize);
+
+  auto prefix = size_t{0};
+  while (prefix < minSize &&
+         fragmentsEqual(oldFragments[prefix], newFragments[prefix])) {
+    prefix++;
+  }
+
+  auto suffix = size_t{0};
+  while (suffix < minSize - prefix &&
+         fragmentsEqual(
+             oldFragments[oldSize - 1 - suffix],
+             newFragments[newSize - 1 - suffix])) {
+    suffix++;
+  }
+
+  auto oldChangedSize = oldSize - prefix - suffix;
+  auto newChangedSize = newSize - prefix - suffix;
+  auto pairedSize = std::min(oldChangedSize, newChangedSize);
+
+  for (auto i = prefix; i < prefix + pairedSize; i++) {
+    auto const &oldFragment = oldFragments[i];
+    auto const &newFragment = newFragments[i];
+
+    auto edit = Edit{};
+    edit.index = (int)i;
+    if (fragmentsEqualExceptString(oldFragment, newFragment)) {
+      edit.type = Edit::Type::UpdateString;
+      edit.range = changedRange(oldFragment.string, newFragment.string);
+      edit.string = newFragment.string.substr(
+          edit.range.location,
+          newFragment.string.size() - oldFragment.string.size() +
+              edit.range.length);
+    } else {
+      edit.type = Edit::Type::Update;
+      edit.fragment = newFragment;
+    }
+    edits.push_back(std::move(edit));
+  }
+
+  auto index = (int)(prefix + pairedSize);
+  for (auto i = pairedSize; i < oldChangedSize; i++) {
+    auto edit = Edit{};
+    edit.type = Edit::Type::Remove;
+    edit.index = index;
+    edits.push_back(std::move(edit));
+  }
+
+  for (auto i = prefix + pairedSize; i < prefix + newChangedSize; i++) {
+    auto edit = Edit{};
+    edit.type = Edit::Type::Insert;
+    edit.index = (int)i;
+    edit.fragment = newFragments[i];
+    edits.push_back(std::move(edit));
+  }
+
+  return edits;
+}
+
+void AttributedString::applyEdits(const Edits &edits) {
+  ensureUnsealed();
+  invalidateMemoizedValues();
+
+  for (auto const &edit : edits) {
+    switch (edit.type) {
+      case Edit::Type::Insert:
+        fragments_.insert(fragments_.begin() + edit.index, edit.fragment);
+        break;
+      case Edit::Type::Remove:
+        fragments_.erase(fragments_.begin() + edit.index);
+        break;
+      case Edit::Type::Update:
+        fragments_[edit.index] = edit.fragment;
+        break;
+      case Edit::Type::UpdateString:
+        fragments_[edit.index].string.replace(
+            edit.range.location, edit.range.length, edit.string);
+        break;
+    }
+  }
+}
+
+size_t AttributedString::getHash() const {
+  auto hash = hash_.load(std::memory_order_relaxed);
+  if (hash != 0) {
+    return hash;
+  }
+
+  // Only fields which `operator==` compares exactly are hashed, so equal
+  // strings always have equal hashes: `std::hash<Fragment>` covers the whole
+  // parent shadow view, and text attributes compare floats with a tolerance.
+  for (const auto &fragment : fragments_) {
+    hash = folly::hash::hash_combine(
+        hash, fragment.string, fragment.parentShadowView.tag);
+  }
+
+  hash_.store(hash, std::memory_order_relaxed);
+  return hash;
+}
+
 bool AttributedString::operator==(const AttributedString &rhs) const {
-  return fragments_ == rhs.fragments_;
+  if (this == &rhs) {
+    return true;
+  }
+
+  if (fragments_.size() != rhs.fragments_.size()) {
+    return false;
+  }
+
+  // Equal strings have equal hashes, so memoized hashes (if both sides have
+  // them) can reject most of the unequal strings without comparing fragments.
+  auto hash = hash_.load(std::memory_order_relaxed);
+  auto rhsHash = rhs.hash_.load(std::memory_order_relaxed);
+  if (hash != 0 && rhsHash != 0 && hash != rhsHash) {
+    return false;
+  }
+
+  for (size_t i = 0; i < fragments_.size(); i++) {
+    if (!fragmentsEqual(fragments_[i], rhs.fragments_[i])) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 bool AttributedString::operator!=(const AttributedString &rhs) const {
   return !(*this == rhs);
 }
 
+std::shared_ptr<AttributedString::StringIndex const>
+AttributedString::getStringIndex() const {
+  auto stringIndex = loadStringIndex();
+  if (stringIndex) {
+    return stringIndex;
+  }
+
+  auto length = size_t{0};
+  for (const auto &fragment : fragments_) {
+    length += fragment.string.size();
+  }
+
+  auto newStringIndex = std::make_shared<StringIndex>();
+  auto &string = newStringIndex->string;
+  string.reserve(length);
+  for (const auto &fragment : fragments_) {
+    string += fragment.string;
+  }
+
+  auto isASCII = std::all_of(string.begin(), string.end(), [](char byte) {
+    return ((unsigned char)byte & 0x80) == 0;
+  });
+
+  if (isASCII) {
+    newStringIndex->utf16Length = (int)string.size();
+  } else {
+    auto &checkpoints = newStringIndex->utf16Checkpoints;
+    checkpoints.reserve(string.size() / kUTF16CheckpointInterval + 1);
+
+    auto utf16Offset = 0;
+    for (size_t i = 0; i < string.size(); i++) {
+      if (i % kUTF16CheckpointInterval == 0) {
+        checkpoints.push_back(utf16Offset);
+      }
+      auto byte = (unsigned char)string[i];
+      if (isCodePointStart(byte)) {
+        utf16Offset += utf16LengthOfCodePoint(byte);
+      }
+    }
+    // Offsets at the end of the string index past the last checkpoint.
+    if (string.size() % kUTF16CheckpointInterval == 0) {
+      checkpoints.push_back(utf16Offset);
+    }
+    newStringIndex->utf16Length = utf16Offset;
+  }
+
+  // Concurrent callers might build the index simultaneously; all of them
+  // produce an identical value, so it does not matter which one is kept.
+  stringIndex = newStringIndex;
+  std::atomic_store(&stringIndex_, stringIndex);
+  hasStringIndex_.store(true, std::memory_order_release);
+  return stringIndex;
+}
+
+std::shared_ptr<AttributedString::StringIndex const>
+AttributedString::loadStringIndex() const {
+  if (!hasStringIndex_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return std::atomic_load(&stringIndex_);
+}
+
+void AttributedString::invalidateMemoizedValues() {
+  hash_.store(0, std::memory_order_relaxed);
+  // Mutations require exclusive access, so nothing can be loading the index.
+  if (hasStringIndex_.load(std::memory_order_relaxed)) {
+    hasStringIndex_.store(false, std::memory_order_relaxed);
+    stringIndex_.reset();
+  }
+}
+
 #pragma mark - DebugStringConvertible
 
 #if ABI44_0_0RN_DEBUG_STRING_CONVERTIBLE
@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <folly/Hash.h>
 #include <folly/Optional.h>
@@ -59,18 +61,75 @@ class AttributedString : public Sealable, public DebugStringConvertible {
 
   using Fragments = better::small_vector<Fragment, 1>;
 
+  /*
+   * A single step of an edit script produced by `diff()`.
+   * `index` refers to the list of fragments as it is after all previous
+   * edits of the script have been applied.
+   */
+  class Edit {
+   public:
+    enum class Type {
+      /*
+       * Inserts `fragment` at `index`.
+       */
+      Insert,
+
+      /*
+       * Removes the fragment at `index`.
+       */
+      Remove,
+
+      /*
+       * Replaces the fragment at `index` with `fragment`. Used when text
+       * attributes or the parent shadow view of the fragment changed.
+       */
+      Update,
+
+      /*
+       * Replaces `range` (in UTF-8 code units, relative to the fragment) of
+       * the string of the fragment at `index` with `string`. Used when only
+       * the string of the fragment changed.
+       */
+      UpdateString,
+    };
+
+    Type type;
+    int index{0};
+    Fragment fragment{};
+    Range range{};
+    std::string string{};
+  };
+
+  using Edits = std::vector<Edit>;
+
+  AttributedString() = default;
+  AttributedString(AttributedString const &other);
+  AttributedString(AttributedString &&other) noexcept;
+  AttributedString &operator=(AttributedString const &other);
+  AttributedString &operator=(AttributedString &&other) noexcept;
+
   /*
    * Appends and prepends a `fragment` to the string.
    */
   void appendFragment(const Fragment &fragment);
   void prependFragment(const Fragment &fragment);
+  void appendFragment(Fragment &&fragment);
+  void prependFragment(Fragment &&fragment);
 
   /*
    * Appends and prepends an `attributedString` (all its fragments) to
    * the string.
+   * Prepending moves all existing fragments, so building a string from the
+   * end is quadratic; use `AttributedStringBuilder` for that.
    */
   void appendAttributedString(const AttributedString &attributedString);
   void prependAttributedString(const AttributedString &attributedString);
+  void appendAttributedString(AttributedString &&attributedString);
+
+  /*
+   * Reserves storage for `capacity` fragments.
+   */
+  void reserve(size_t capacity);
 
   /*
    * Returns a read-only reference to a list of fragments.
@@ -79,6 +138,9 @@ class AttributedString : public Sealable, public DebugStringConvertible {
 
   /*
    * Returns a reference to a list of fragments.
+   * Since the fragments can be mutated through the reference, this drops
+   * all memoized values. The reference must not be used to mutate the string
+   * after it was hashed or compared.
    */
   Fragments &getFragments();
 
@@ -87,6 +149,33 @@ class AttributedString : public Sealable, public DebugStringConvertible {
    */
   std::string getString() const;
 
+  /*
+   * Same as `getString()`, but returns a reference to a memoized string
+   * instead of building a new one. The string is built on first use and kept
+   * until the `AttributedString` is mutated; the reference is valid until
+   * then (or until the `AttributedString` is destroyed).
+   */
+  std::string const &getCachedString() const;
+
+  /*
+   * Convert offsets in `getString()` between UTF-8 code units (bytes, used
+   * by fragments) and UTF-16 code units (used by platform text APIs for
+   * ranges and selections). Out-of-bounds offsets are clamped; a UTF-16
+   * offset pointing inside a surrogate pair is rounded up to the next code
+   * point.
+   * The conversion is a lookup in an index memoized together with
+   * `getCachedString()`, it does not rescan the string.
+   */
+  int getUTF16Offset(int utf8Offset) const;
+  int getUTF8Offset(int utf16Offset) const;
+  Range getUTF16Range(Range const &utf8Range) const;
+  Range getUTF8Range(Range const &utf16Range) const;
+
+  /*
+   * Returns the length of `getString()` in UTF-16 code units.
+   */
+  int getUTF16Length() const;
+
   /*
    * Returns `true` if the string is empty (has no any fragments).
    */
@@ -97,6 +186,31 @@ class AttributedString : public Sealable, public DebugStringConvertible {
    */
   bool compareTextAttributesWithoutFrame(const AttributedString &rhs) const;
 
+  /*
+   * Returns an edit script which turns this string into `rhs`.
+   * Fragments which are equal on both sides at the beginning and at the end
+   * are skipped and the remaining ones are matched by position, so the size
+   * of the script is proportional to the size of the change rather than to
+   * the size of the string. Edits of a string contained within a fragment
+   * are narrowed down to the range of code points that actually changed.
+   */
+  Edits diff(const AttributedString &rhs) const;
+
+  /*
+   * Applies an edit script produced by `diff()` to the string.
+   * The string must be in the same state as the one `diff()` was called on.
+   */
+  void applyEdits(const Edits &edits);
+
+  /*
+   * Returns a hash of all fragments of the string, consistent with
+   * `operator==`. Text attributes are not hashed.
+   * The value is computed on first use and memoized until the string is
+   * mutated. Sealed strings cannot be mutated, so their hash is computed at
+   * most once.
+   */
+  size_t getHash() const;
+
   bool operator==(const AttributedString &rhs) const;
   bool operator!=(const AttributedString &rhs) const;
 
@@ -107,7 +221,57 @@ class AttributedString : public Sealable, public DebugStringConvertible {
 #endif
 
  private:
+  friend class AttributedStringBuilder;
+
+  /*
+   * Flattened string together with an index for UTF-8 <-> UTF-16 offset
+   * conversions. Immutable once built.
+   */
+  struct StringIndex {
+    std::string string;
+
+    /*
+     * UTF-16 offsets of every `kUTF16CheckpointInterval`-th byte of
+     * `string`, including its end if it falls on one. Empty if `string` is
+     * pure ASCII, in which case UTF-8 and UTF-16 offsets are identical.
+     */
+    std::vector<int> utf16Checkpoints;
+
+    int utf16Length{0};
+  };
+
+  /*
+   * Returns the memoized `StringIndex`, building it if needed.
+   */
+  std::shared_ptr<StringIndex const> getStringIndex() const;
+
+  /*
+   * Returns the memoized `StringIndex` if there is one.
+   */
+  std::shared_ptr<StringIndex const> loadStringIndex() const;
+
+  /*
+   * Drops all values memoized from `fragments_`.
+   * Must be called by every method that can mutate the fragments.
+   */
+  void invalidateMemoizedValues();
+
   Fragments fragments_;
+
+  /*
+   * Memoized result of `getHash()`; zero means "not computed yet".
+   */
+  mutable std::atomic<size_t> hash_{0};
+
+  /*
+   * Memoized result of `getStringIndex()`. Const methods access it only
+   * through `std::atomic_load`/`std::atomic_store`, and only once
+   * `hasStringIndex_` is set; methods which require exclusive access (as
+   * mutations and moves do) access it directly. Strings which were never
+   * converted thus never take the lock of the atomic accessors.
+   */
+  mutable std::shared_ptr<StringIndex const> stringIndex_;
+  mutable std::atomic<bool> hasStringIndex_{false};
 };
 
 } // namespace ABI44_0_0React
@@ -127,13 +291,7 @@ template <>
 struct hash<ABI44_0_0facebook::ABI44_0_0React::AttributedString> {
   size_t operator()(
       const ABI44_0_0facebook::ABI44_0_0React::AttributedString &attributedString) const {
-    auto seed = size_t{0};
-
-    for (const auto &fragment : attributedString.getFragments()) {
-      seed = folly::hash::hash_combine(seed, fragment);
-    }
-
-    return seed;
+    return attributedString.getHash();
   }
 };
 } // namespace std
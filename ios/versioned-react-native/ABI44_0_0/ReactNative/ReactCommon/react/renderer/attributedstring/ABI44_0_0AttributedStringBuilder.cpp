@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ABI44_0_0AttributedStringBuilder.h"
+
+#include <iterator>
+
+namespace ABI44_0_0facebook {
+namespace ABI44_0_0React {
+
+/*
+ * Maximum number of recycled fragments kept by a builder, so a single huge
+ * string does not pin its memory forever.
+ */
+static constexpr size_t kMaxRecycledFragments = 64;
+
+AttributedStringBuilder::AttributedStringBuilder(size_t capacity) {
+  reserve(capacity);
+}
+
+void AttributedStringBuilder::reserve(size_t capacity) {
+  appendedFragments_.reserve(capacity);
+}
+
+void AttributedStringBuilder::appendFragment(Fragment const &fragment) {
+  if (fragment.string.empty()) {
+    return;
+  }
+  appendedFragments_.push_back(makeFragment(fragment));
+}
+
+void AttributedStringBuilder::appendFragment(Fragment &&fragment) {
+  if (fragment.string.empty()) {
+    return;
+  }
+  appendedFragments_.push_back(std::move(fragment));
+}
+
+void AttributedStringBuilder::prependFragment(Fragment const &fragment) {
+  if (fragment.string.empty()) {
+    return;
+  }
+  prependedFragments_.push_back(makeFragment(fragment));
+}
+
+void AttributedStringBuilder::prependFragment(Fragment &&fragment) {
+  if (fragment.string.empty()) {
+    return;
+  }
+  prependedFragments_.push_back(std::move(fragment));
+}
+
+void AttributedStringBuilder::appendAttributedString(
+    AttributedString const &attributedString) {
+  for (auto const &fragment : attributedString.getFragments()) {
+    appendedFragments_.push_back(makeFragment(fragment));
+  }
+}
+
+void AttributedStringBuilder::appendAttributedString(
+    AttributedString &&attributedString) {
+  auto &fragments = attributedString.fragments_;
+  appendedFragments_.insert(
+      appendedFragments_.end(),
+      std::make_move_iterator(fragments.begin()),
+      std::make_move_iterator(fragments.end()));
+  fragments.clear();
+  attributedString.invalidateMemoizedValues();
+}
+
+void AttributedStringBuilder::prependAttributedString(
+    AttributedString const &attributedString) {
+  auto const &fragments = attributedString.getFragments();
+  for (auto it = fragments.rbegin(); it != fragments.rend(); it++) {
+    prependedFragments_.push_back(makeFragment(*it));
+  }
+}
+
+void AttributedStringBuilder::recycle(AttributedString &&attributedString) {
+  attributedString.ensureUnsealed();
+
+  auto &fragments = attributedString.fragments_;
+  for (auto &fragment : fragments) {
+    if (recycledFragments_.size() >= kMaxRecycledFragments) {
+      break;
+    }
+    // Only the buffers are reused; the shadow view would keep props and
+    // state of a node alive.
+    fragment.parentShadowView = ShadowView{};
+    recycledFragments_.push_back(std::move(fragment));
+  }
+  fragments.clear();
+  attributedString.invalidateMemoizedValues();
+
+  if (fragments.capacity() > recycledStorage_.capacity()) {
+    recycledStorage_ = std::move(fragments);
+    recycledStorage_.clear();
+  }
+}
+
+size_t AttributedStringBuilder::size() const {
+  return prependedFragments_.size() + appendedFragments_.size();
+}
+
+AttributedString AttributedStringBuilder::build() {
+  auto attributedString = buildUnsealed();
+  attributedString.seal();
+  return attributedString;
+}
+
+AttributedString AttributedStringBuilder::buildUnsealed() {
+  auto attributedString = AttributedString{};
+  auto &fragments = attributedString.fragments_;
+  fragments = std::move(recycledStorage_);
+  fragments.clear();
+  recycledStorage_ = AttributedString::Fragments{};
+  fragments.reserve(size());
+
+  // Collected fragments are never empty, and a new string has nothing
+  // memoized, so they are moved in as a whole.
+  fragments.insert(
+      fragments.end(),
+      std::make_move_iterator(prependedFragments_.rbegin()),
+      std::make_move_iterator(prependedFragments_.rend()));
+  fragments.insert(
+      fragments.end(),
+      std::make_move_iterator(appendedFragments_.begin()),
+      std::make_move_iterator(appendedFragments_.end()));
+
+  prependedFragments_.clear();
+  appendedFragments_.clear();
+  return attributedString;
+}
+
+AttributedStringBuilder::Fragment AttributedStringBuilder::makeFragment(
+    Fragment const &fragment) {
+  if (recycledFragments_.empty()) {
+    return fragment;
+  }
+
+  // Assignments reuse buffers the recycled fragment already owns.
+  auto recycledFragment = std::move(recycledFragments_.back());
+  recycledFragments_.pop_back();
+  recycledFragment.string.assign(fragment.string);
+  recycledFragment.textAttributes = fragment.textAttributes;
+  recycledFragment.parentShadowView = fragment.parentShadowView;
+  return recycledFragment;
+}
+
+} // namespace ABI44_0_0React
+} // namespace ABI44_0_0facebook
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedString.h>
+
+namespace ABI44_0_0facebook {
+namespace ABI44_0_0React {
+
+/*
+ * Incrementally builds an `AttributedString`.
+ * Unlike mutating an `AttributedString` directly, fragments can be moved in,
+ * and both appending and prepending are amortized O(1): prepended fragments
+ * are collected in reverse order and put in place once, in `build()`.
+ * The class is not thread-safe.
+ */
+class AttributedStringBuilder final {
+ public:
+  using Fragment = AttributedString::Fragment;
+
+  AttributedStringBuilder() = default;
+
+  /*
+   * Reserves storage for `capacity` appended fragments (prepended
+   * fragments are stored separately and are not covered).
+   */
+  explicit AttributedStringBuilder(size_t capacity);
+  void reserve(size_t capacity);
+
+  /*
+   * Appends and prepends a `fragment`. Fragments with empty strings are
+   * ignored, as `AttributedString` does.
+   */
+  void appendFragment(Fragment const &fragment);
+  void appendFragment(Fragment &&fragment);
+  void prependFragment(Fragment const &fragment);
+  void prependFragment(Fragment &&fragment);
+
+  /*
+   * Appends and prepends all fragments of an `attributedString`.
+   */
+  void appendAttributedString(AttributedString const &attributedString);
+  void appendAttributedString(AttributedString &&attributedString);
+  void prependAttributedString(AttributedString const &attributedString);
+
+  /*
+   * Hands a no longer needed `attributedString` back to the builder, so
+   * storage of its fragments (string buffers in particular) and its list of
+   * fragments are reused by the following `append*`/`prepend*` and `build()`
+   * calls instead of being freed and allocated again.
+   * Meant for strings which are rebuilt and thrown away over and over again,
+   * such as the temporary strings constructed during text measurement. The
+   * string is mutated, so it must not be sealed (see `buildUnsealed()`).
+   * Parent shadow views of recycled fragments are released right away.
+   */
+  void recycle(AttributedString &&attributedString);
+
+  /*
+   * Returns the number of fragments collected so far.
+   */
+  size_t size() const;
+
+  /*
+   * Moves collected fragments into a new sealed `AttributedString` and
+   * resets the builder, so it can be reused.
+   */
+  AttributedString build();
+
+  /*
+   * Same as `build()`, but leaves the string unsealed, so it can be mutated
+   * and handed back to `recycle()` once it is no longer needed.
+   */
+  AttributedString buildUnsealed();
+
+ private:
+  /*
+   * Returns a copy of `fragment`, made from a recycled fragment if one is
+   * available.
+   */
+  Fragment makeFragment(Fragment const &fragment);
+
+  /*
+   * Prepended fragments in reverse order (the first one is the last one
+   * that was prepended).
+   */
+  std::vector<Fragment> prependedFragments_;
+  std::vector<Fragment> appendedFragments_;
+
+  /*
+   * Fragments and the storage of the list of fragments of recycled
+   * strings.
+   */
+  std::vector<Fragment> recycledFragments_;
+  AttributedString::Fragments recycledStorage_;
+};
+
+} // namespace ABI44_0_0React
+} // namespace ABI44_0_0facebook
@@ -18,134 +18,146 @@
 namespace ABI44_0_0facebook {
 namespace ABI44_0_0React {
 
-void TextAttributes::apply(TextAttributes textAttributes) {
+void TextAttributes::apply(TextAttributes const &textAttributes) {
+  // Only attributes that are set are assigned, which avoids copying (and
+  // self-assigning) strings and colors that are not overridden.
+
   // Color
-  foregroundColor = textAttributes.foregroundColor
-      ? textAttributes.foregroundColor
-      : foregroundColor;
-  backgroundColor = textAttributes.backgroundColor
-      ? textAttributes.backgroundColor
-      : backgroundColor;
-  opacity =
-      !std::isnan(textAttributes.opacity) ? textAttributes.opacity : opacity;
+  if (textAttributes.foregroundColor) {
+    foregroundColor = textAttributes.foregroundColor;
+  }
+  if (textAttributes.backgroundColor) {
+    backgroundColor = textAttributes.backgroundColor;
+  }
+  if (!std::isnan(textAttributes.opacity)) {
+    opacity = textAttributes.opacity;
+  }
 
   // Font
-  fontFamily = !textAttributes.fontFamily.empty() ? textAttributes.fontFamily
-                                                  : fontFamily;
-  fontSize =
-      !std::isnan(textAttributes.fontSize) ? textAttributes.fontSize : fontSize;
-  fontSizeMultiplier = !std::isnan(textAttributes.fontSizeMultiplier)
-      ? textAttributes.fontSizeMultiplier
-      : fontSizeMultiplier;
-  fontWeight = textAttributes.fontWeight.hasValue() ? textAttributes.fontWeight
-                                                    : fontWeight;
-  fontStyle = textAttributes.fontStyle.hasValue() ? textAttributes.fontStyle
-                                                  : fontStyle;
-  fontVariant = textAttributes.fontVariant.hasValue()
-      ? textAttributes.fontVariant
-      : fontVariant;
-  allowFontScaling = textAttributes.allowFontScaling.hasValue()
-      ? textAttributes.allowFontScaling
-      : allowFontScaling;
-  letterSpacing = !std::isnan(textAttributes.letterSpacing)
-      ? textAttributes.letterSpacing
-      : letterSpacing;
+  if (!textAttributes.fontFamily.empty()) {
+    fontFamily = textAttributes.fontFamily;
+  }
+  if (!std::isnan(textAttributes.fontSize)) {
+    fontSize = textAttributes.fontSize;
+  }
+  if (!std::isnan(textAttributes.fontSizeMultiplier)) {
+    fontSizeMultiplier = textAttributes.fontSizeMultiplier;
+  }
+  if (textAttributes.fontWeight.hasValue()) {
+    fontWeight = textAttributes.fontWeight;
+  }
+  if (textAttributes.fontStyle.hasValue()) {
+    fontStyle = textAttributes.fontStyle;
+  }
+  if (textAttributes.fontVariant.hasValue()) {
+    fontVariant = textAttributes.fontVariant;
+  }
+  if (textAttributes.allowFontScaling.hasValue()) {
+    allowFontScaling = textAttributes.allowFontScaling;
+  }
+  if (!std::isnan(textAttributes.letterSpacing)) {
+    letterSpacing = textAttributes.letterSpacing;
+  }
 
   // Paragraph Styles
-  lineHeight = !std::isnan(textAttributes.lineHeight)
-      ? textAttributes.lineHeight
-      : lineHeight;
-  alignment = textAttributes.alignment.hasValue() ? textAttributes.alignment
-                                                  : alignment;
-  baseWritingDirection = textAttributes.baseWritingDirection.hasValue()
-      ? textAttributes.baseWritingDirection
-      : baseWritingDirection;
+  if (!std::isnan(textAttributes.lineHeight)) {
+    lineHeight = textAttributes.lineHeight;
+  }
+  if (textAttributes.alignment.hasValue()) {
+    alignment = textAttributes.alignment;
+  }
+  if (textAttributes.baseWritingDirection.hasValue()) {
+    baseWritingDirection = textAttributes.baseWritingDirection;
+  }
 
   // Decoration
-  textDecorationColor = textAttributes.textDecorationColor
-      ? textAttributes.textDecorationColor
-      : textDecorationColor;
-  textDecorationLineType = textAttributes.textDecorationLineType.hasValue()
-      ? textAttributes.textDecorationLineType
-      : textDecorationLineType;
-  textDecorationLineStyle = textAttributes.textDecorationLineStyle.hasValue()
-      ? textAttributes.textDecorationLineStyle
-      : textDecorationLineStyle;
-  textDecorationLinePattern =
-      textAttributes.textDecorationLinePattern.hasValue()
-      ? textAttributes.textDecorationLinePattern
-      : textDecorationLinePattern;
+  if (textAttributes.textDecorationColor) {
+    textDecorationColor = textAttributes.textDecorationColor;
+  }
+  if (textAttributes.textDecorationLineType.hasValue()) {
+    textDecorationLineType = textAttributes.textDecorationLineType;
+  }
+  if (textAttributes.textDecorationLineStyle.hasValue()) {
+    textDecorationLineStyle = textAttributes.textDecorationLineStyle;
+  }
+  if (textAttributes.textDecorationLinePattern.hasValue()) {
+    textDecorationLinePattern = textAttributes.textDecorationLinePattern;
+  }
 
   // Shadow
-  textShadowOffset = textAttributes.textShadowOffset.hasValue()
-      ? textAttributes.textShadowOffset.value()
-      : textShadowOffset;
-  textShadowRadius = !std::isnan(textAttributes.textShadowRadius)
-      ? textAttributes.textShadowRadius
-      : textShadowRadius;
-  textShadowColor = textAttributes.textShadowColor
-      ? textAttributes.textShadowColor
-      : textShadowColor;
+  if (textAttributes.textShadowOffset.hasValue()) {
+    textShadowOffset = textAttributes.textShadowOffset;
+  }
+  if (!std::isnan(textAttributes.textShadowRadius)) {
+    textShadowRadius = textAttributes.textShadowRadius;
+  }
+  if (textAttributes.textShadowColor) {
+    textShadowColor = textAttributes.textShadowColor;
+  }
 
   // Special
-  isHighlighted = textAttributes.isHighlighted.hasValue()
-      ? textAttributes.isHighlighted
-      : isHighlighted;
-  layoutDirection = textAttributes.layoutDirection.hasValue()
-      ? textAttributes.layoutDirection
-      : layoutDirection;
-  accessibilityRole = textAttributes.accessibilityRole.hasValue()
-      ? textAttributes.accessibilityRole
-      : accessibilityRole;
+  if (textAttributes.isHighlighted.hasValue()) {
+    isHighlighted = textAttributes.isHighlighted;
+  }
+  if (textAttributes.layoutDirection.hasValue()) {
+    layoutDirection = textAttributes.layoutDirection;
+  }
+  if (textAttributes.accessibilityRole.hasValue()) {
+    accessibilityRole = textAttributes.accessibilityRole;
+  }
 }
 
 #pragma mark - Operators
 
 bool TextAttributes::operator==(const TextAttributes &rhs) const {
-  return std::tie(
-             foregroundColor,
-             backgroundColor,
-             fontFamily,
+  // Cheap scalar attributes (the ones which differ most often between
+  // styles) are compared first, so unequal attributes are usually rejected
+  // before comparing colors and the font family string.
+  return floatEquality(fontSize, rhs.fontSize) &&
+      std::tie(
              fontWeight,
              fontStyle,
              fontVariant,
              allowFontScaling,
              alignment,
              baseWritingDirection,
-             textDecorationColor,
              textDecorationLineType,
              textDecorationLineStyle,
              textDecorationLinePattern,
-             textShadowOffset,
-             textShadowColor,
              isHighlighted,
              layoutDirection,
              accessibilityRole) ==
       std::tie(
-             rhs.foregroundColor,
-             rhs.backgroundColor,
-             rhs.fontFamily,
              rhs.fontWeight,
              rhs.fontStyle,
              rhs.fontVariant,
              rhs.allowFontScaling,
              rhs.alignment,
              rhs.baseWritingDirection,
-             rhs.textDecorationColor,
              rhs.textDecorationLineType,
              rhs.textDecorationLineStyle,
              rhs.textDecorationLinePattern,
-             rhs.textShadowOffset,
-             rhs.textShadowColor,
              rhs.isHighlighted,
              rhs.layoutDirection,
              rhs.accessibilityRole) &&
       floatEquality(opacity, rhs.opacity) &&
-      floatEquality(fontSize, rhs.fontSize) &&
       floatEquality(fontSizeMultiplier, rhs.fontSizeMultiplier) &&
       floatEquality(letterSpacing, rhs.letterSpacing) &&
       floatEquality(lineHeight, rhs.lineHeight) &&
-      floatEquality(textShadowRadius, rhs.textShadowRadius);
+      floatEquality(textShadowRadius, rhs.textShadowRadius) &&
+      std::tie(
+             foregroundColor,
+             backgroundColor,
+             textDecorationColor,
+             textShadowColor,
+             textShadowOffset) ==
+      std::tie(
+             rhs.foregroundColor,
+             rhs.backgroundColor,
+             rhs.textDecorationColor,
+             rhs.textShadowColor,
+             rhs.textShadowOffset) &&
+      fontFamily == rhs.fontFamily;
 }
 
 bool TextAttributes::operator!=(const TextAttributes &rhs) const {
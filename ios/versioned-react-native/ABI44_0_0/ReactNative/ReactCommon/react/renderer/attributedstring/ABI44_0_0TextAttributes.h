@@ -81,7 +81,10 @@ class TextAttributes : public DebugStringConvertible {
 
 #pragma mark - Operations
 
-  void apply(TextAttributes textAttributes);
+  /*
+   * Overrides attributes with those that are set in `textAttributes`.
+   */
+  void apply(TextAttributes const &textAttributes);
 
 #pragma mark - Operators
 
@@ -21,125 +21,299 @@
 #include <ABI44_0_0React/ABI44_0_0renderer/graphics/Geometry.h>
 #include <ABI44_0_0React/ABI44_0_0renderer/graphics/conversions.h>
 #include <cmath>
+#include <cstdint>
 
 #include <glog/logging.h>
 
+#ifdef ANDROID
+#include <ABI44_0_0React/ABI44_0_0renderer/mapbuffer/MapBuffer.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/mapbuffer/MapBufferBuilder.h>
+#endif
+
 namespace ABI44_0_0facebook {
 namespace ABI44_0_0React {
 
-inline std::string toString(const EllipsizeMode &ellipsisMode) {
-  switch (ellipsisMode) {
-    case EllipsizeMode::Clip:
-      return "clip";
-    case EllipsizeMode::Head:
-      return "head";
-    case EllipsizeMode::Tail:
-      return "tail";
-    case EllipsizeMode::Middle:
-      return "middle";
+namespace detail {
+
+/*
+ * FNV-1a hash of a string. The `constexpr` overload hashes the names of the
+ * tables below at compile time, so parsing a string value costs one hash of
+ * the input plus a scan over precomputed integers instead of a chain of
+ * string comparisons.
+ */
+constexpr inline uint64_t fnv1aHash(
+    char const *string,
+    uint64_t hash = 14695981039346656037ull) {
+  return *string == '\0'
+      ? hash
+      : fnv1aHash(
+            string + 1,
+            (hash ^ (uint64_t)(unsigned char)*string) * 1099511628211ull);
+}
+
+inline uint64_t fnv1aHash(std::string const &string) {
+  auto hash = uint64_t{14695981039346656037ull};
+  for (auto character : string) {
+    hash = (hash ^ (uint64_t)(unsigned char)character) * 1099511628211ull;
   }
+  return hash;
 }
 
-inline void fromRawValue(const RawValue &value, EllipsizeMode &result) {
-  auto string = (std::string)value;
-  if (string == "clip") {
-    result = EllipsizeMode::Clip;
-    return;
+/*
+ * A string representation of an enum value. A single table of those drives
+ * both `fromRawValue` and `toString` of the enum; when several names map to
+ * the same value (aliases), `toString` returns the first one.
+ */
+template <typename T>
+struct EnumName {
+  constexpr EnumName(char const *name, T value)
+      : name(name), value(value), hash(fnv1aHash(name)) {}
+
+  char const *name;
+  T value;
+  uint64_t hash;
+};
+
+/*
+ * Checked with `static_assert` for every table, so a hash collision between
+ * two names of the same enum is a compile error.
+ */
+template <typename T, size_t N>
+constexpr bool hasDistinctHashes(EnumName<T> const (&names)[N]) {
+  for (size_t i = 0; i < N; i++) {
+    for (size_t j = i + 1; j < N; j++) {
+      if (names[i].hash == names[j].hash) {
+        return false;
+      }
+    }
   }
-  if (string == "head") {
-    result = EllipsizeMode::Head;
-    return;
+  return true;
+}
+
+/*
+ * Returns the entry named `string` or `nullptr`. A matching hash is still
+ * confirmed by comparing the strings, so an unknown value which happens to
+ * collide is never mistaken for a known one.
+ */
+template <typename T, size_t N>
+inline EnumName<T> const *findEnumName(
+    EnumName<T> const (&names)[N],
+    std::string const &string) {
+  auto hash = fnv1aHash(string);
+  for (auto const &name : names) {
+    if (name.hash == hash && string == name.name) {
+      return &name;
+    }
   }
-  if (string == "tail") {
-    result = EllipsizeMode::Tail;
-    return;
+  return nullptr;
+}
+
+template <typename T, size_t N>
+inline std::string enumToString(EnumName<T> const (&names)[N], T value) {
+  for (auto const &name : names) {
+    if (name.value == value) {
+      return name.name;
+    }
   }
-  if (string == "middle") {
-    result = EllipsizeMode::Middle;
-    return;
+  return {};
+}
+
+inline auto const &ellipsizeModeNames() {
+  static constexpr EnumName<EllipsizeMode> names[] = {
+      {"clip", EllipsizeMode::Clip},
+      {"head", EllipsizeMode::Head},
+      {"tail", EllipsizeMode::Tail},
+      {"middle", EllipsizeMode::Middle},
+  };
+  static_assert(hasDistinctHashes(names), "EllipsizeMode names collide.");
+  return names;
+}
+
+inline auto const &textBreakStrategyNames() {
+  static constexpr EnumName<TextBreakStrategy> names[] = {
+      {"simple", TextBreakStrategy::Simple},
+      {"highQuality", TextBreakStrategy::HighQuality},
+      {"balanced", TextBreakStrategy::Balanced},
+  };
+  static_assert(hasDistinctHashes(names), "TextBreakStrategy names collide.");
+  return names;
+}
+
+inline auto const &fontWeightNames() {
+  static constexpr EnumName<FontWeight> names[] = {
+      {"normal", FontWeight::Regular},
+      {"regular", FontWeight::Regular},
+      {"bold", FontWeight::Bold},
+      {"100", FontWeight::Weight100},
+      {"200", FontWeight::Weight200},
+      {"300", FontWeight::Weight300},
+      {"400", FontWeight::Weight400},
+      {"500", FontWeight::Weight500},
+      {"600", FontWeight::Weight600},
+      {"700", FontWeight::Weight700},
+      {"800", FontWeight::Weight800},
+      {"900", FontWeight::Weight900},
+  };
+  static_assert(hasDistinctHashes(names), "FontWeight names collide.");
+  return names;
+}
+
+inline auto const &fontStyleNames() {
+  static constexpr EnumName<FontStyle> names[] = {
+      {"normal", FontStyle::Normal},
+      {"italic", FontStyle::Italic},
+      {"oblique", FontStyle::Oblique},
+  };
+  static_assert(hasDistinctHashes(names), "FontStyle names collide.");
+  return names;
+}
+
+inline auto const &fontVariantNames() {
+  static constexpr EnumName<FontVariant> names[] = {
+      {"small-caps", FontVariant::SmallCaps},
+      {"oldstyle-nums", FontVariant::OldstyleNums},
+      {"lining-nums", FontVariant::LiningNums},
+      {"tabular-nums", FontVariant::TabularNums},
+      {"proportional-nums", FontVariant::ProportionalNums},
+  };
+  static_assert(hasDistinctHashes(names), "FontVariant names collide.");
+  return names;
+}
+
+inline auto const &textAlignmentNames() {
+  static constexpr EnumName<TextAlignment> names[] = {
+      {"auto", TextAlignment::Natural},
+      {"left", TextAlignment::Left},
+      {"center", TextAlignment::Center},
+      {"right", TextAlignment::Right},
+      {"justify", TextAlignment::Justified},
+  };
+  static_assert(hasDistinctHashes(names), "TextAlignment names collide.");
+  return names;
+}
+
+inline auto const &writingDirectionNames() {
+  static constexpr EnumName<WritingDirection> names[] = {
+      {"natural", WritingDirection::Natural},
+      {"ltr", WritingDirection::LeftToRight},
+      {"rtl", WritingDirection::RightToLeft},
+  };
+  static_assert(hasDistinctHashes(names), "WritingDirection names collide.");
+  return names;
+}
+
+inline auto const &textDecorationLineTypeNames() {
+  static constexpr EnumName<TextDecorationLineType> names[] = {
+      {"none", TextDecorationLineType::None},
+      {"underline", TextDecorationLineType::Underline},
+      {"strikethrough", TextDecorationLineType::Strikethrough},
+      {"underline-strikethrough",
+       TextDecorationLineType::UnderlineStrikethrough},
+      // TODO: remove "line-through" after deprecation
+      {"line-through", TextDecorationLineType::Strikethrough},
+      // TODO: remove "underline line-through" after "line-through" deprecation
+      {"underline line-through",
+       TextDecorationLineType::UnderlineStrikethrough},
+  };
+  static_assert(
+      hasDistinctHashes(names), "TextDecorationLineType names collide.");
+  return names;
+}
+
+inline auto const &textDecorationLineStyleNames() {
+  static constexpr EnumName<TextDecorationLineStyle> names[] = {
+      {"single", TextDecorationLineStyle::Single},
+      {"thick", TextDecorationLineStyle::Thick},
+      {"double", TextDecorationLineStyle::Double},
+  };
+  static_assert(
+      hasDistinctHashes(names), "TextDecorationLineStyle names collide.");
+  return names;
+}
+
+inline auto const &textDecorationLinePatternNames() {
+  static constexpr EnumName<TextDecorationLinePattern> names[] = {
+      {"solid", TextDecorationLinePattern::Solid},
+      {"dot", TextDecorationLinePattern::Dot},
+      {"dash", TextDecorationLinePattern::Dash},
+      {"dash-dot", TextDecorationLinePattern::DashDot},
+      {"dash-dot-dot", TextDecorationLinePattern::DashDotDot},
+  };
+  static_assert(
+      hasDistinctHashes(names), "TextDecorationLinePattern names collide.");
+  return names;
+}
+
+inline auto const &accessibilityRoleNames() {
+  static constexpr EnumName<AccessibilityRole> names[] = {
+      {"none", AccessibilityRole::None},
+      {"button", AccessibilityRole::Button},
+      {"link", AccessibilityRole::Link},
+      {"search", AccessibilityRole::Search},
+      {"image", AccessibilityRole::Image},
+      {"imagebutton", AccessibilityRole::Imagebutton},
+      {"keyboardkey", AccessibilityRole::Keyboardkey},
+      {"text", AccessibilityRole::Text},
+      {"adjustable", AccessibilityRole::Adjustable},
+      {"summary", AccessibilityRole::Summary},
+      {"header", AccessibilityRole::Header},
+      {"alert", AccessibilityRole::Alert},
+      {"checkbox", AccessibilityRole::Checkbox},
+      {"combobox", AccessibilityRole::Combobox},
+      {"menu", AccessibilityRole::Menu},
+      {"menubar", AccessibilityRole::Menubar},
+      {"menuitem", AccessibilityRole::Menuitem},
+      {"progressbar", AccessibilityRole::Progressbar},
+      {"radio", AccessibilityRole::Radio},
+      {"radiogroup", AccessibilityRole::Radiogroup},
+      {"scrollbar", AccessibilityRole::Scrollbar},
+      {"spinbutton", AccessibilityRole::Spinbutton},
+      {"switch", AccessibilityRole::Switch},
+      {"tab", AccessibilityRole::Tab},
+      {"tablist", AccessibilityRole::Tablist},
+      {"timer", AccessibilityRole::Timer},
+      {"toolbar", AccessibilityRole::Toolbar},
+  };
+  static_assert(hasDistinctHashes(names), "AccessibilityRole names collide.");
+  return names;
+}
+
+} // namespace detail
+
+inline std::string toString(const EllipsizeMode &ellipsisMode) {
+  return detail::enumToString(detail::ellipsizeModeNames(), ellipsisMode);
+}
+
+inline void fromRawValue(const RawValue &value, EllipsizeMode &result) {
+  auto name =
+      detail::findEnumName(detail::ellipsizeModeNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(const TextBreakStrategy &textBreakStrategy) {
-  switch (textBreakStrategy) {
-    case TextBreakStrategy::Simple:
-      return "simple";
-    case TextBreakStrategy::HighQuality:
-      return "highQuality";
-    case TextBreakStrategy::Balanced:
-      return "balanced";
-  }
+  return detail::enumToString(
+      detail::textBreakStrategyNames(), textBreakStrategy);
 }
 
 inline void fromRawValue(const RawValue &value, TextBreakStrategy &result) {
-  auto string = (std::string)value;
-  if (string == "simple") {
-    result = TextBreakStrategy::Simple;
-    return;
+  auto name = detail::findEnumName(
+      detail::textBreakStrategyNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "highQuality") {
-    result = TextBreakStrategy::HighQuality;
-    return;
-  }
-  if (string == "balanced") {
-    result = TextBreakStrategy::Balanced;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline void fromRawValue(const RawValue &value, FontWeight &result) {
-  auto string = (std::string)value;
-  if (string == "normal") {
-    result = FontWeight::Regular;
-    return;
-  }
-  if (string == "regular") {
-    result = FontWeight::Regular;
-    return;
-  }
-  if (string == "bold") {
-    result = FontWeight::Bold;
-    return;
-  }
-  if (string == "100") {
-    result = FontWeight::Weight100;
-    return;
-  }
-  if (string == "200") {
-    result = FontWeight::Weight200;
-    return;
-  }
-  if (string == "300") {
-    result = FontWeight::Weight300;
-    return;
+  auto name =
+      detail::findEnumName(detail::fontWeightNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "400") {
-    result = FontWeight::Weight400;
-    return;
-  }
-  if (string == "500") {
-    result = FontWeight::Weight500;
-    return;
-  }
-  if (string == "600") {
-    result = FontWeight::Weight600;
-    return;
-  }
-  if (string == "700") {
-    result = FontWeight::Weight700;
-    return;
-  }
-  if (string == "800") {
-    result = FontWeight::Weight800;
-    return;
-  }
-  if (string == "900") {
-    result = FontWeight::Weight900;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(const FontWeight &fontWeight) {
@@ -147,31 +321,16 @@ inline std::string toString(const FontWeight &fontWeight) {
 }
 
 inline void fromRawValue(const RawValue &value, FontStyle &result) {
-  auto string = (std::string)value;
-  if (string == "normal") {
-    result = FontStyle::Normal;
-    return;
-  }
-  if (string == "italic") {
-    result = FontStyle::Italic;
-    return;
+  auto name =
+      detail::findEnumName(detail::fontStyleNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "oblique") {
-    result = FontStyle::Oblique;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(const FontStyle &fontStyle) {
-  switch (fontStyle) {
-    case FontStyle::Normal:
-      return "normal";
-    case FontStyle::Italic:
-      return "italic";
-    case FontStyle::Oblique:
-      return "oblique";
-  }
+  return detail::enumToString(detail::fontStyleNames(), fontStyle);
 }
 
 inline void fromRawValue(const RawValue &value, FontVariant &result) {
@@ -179,25 +338,9 @@ inline void fromRawValue(const RawValue &value, FontVariant &result) {
   result = FontVariant::Default;
   auto items = std::vector<std::string>{value};
   for (const auto &item : items) {
-    if (item == "small-caps") {
-      result = (FontVariant)((int)result | (int)FontVariant::SmallCaps);
-      continue;
-    }
-    if (item == "oldstyle-nums") {
-      result = (FontVariant)((int)result | (int)FontVariant::OldstyleNums);
-      continue;
-    }
-    if (item == "lining-nums") {
-      result = (FontVariant)((int)result | (int)FontVariant::LiningNums);
-      continue;
-    }
-    if (item == "tabular-nums") {
-      result = (FontVariant)((int)result | (int)FontVariant::TabularNums);
-      continue;
-    }
-    if (item == "proportional-nums") {
-      result = (FontVariant)((int)result | (int)FontVariant::ProportionalNums);
-      continue;
+    auto name = detail::findEnumName(detail::fontVariantNames(), item);
+    if (name != nullptr) {
+      result = (FontVariant)((int)result | (int)name->value);
     }
   }
 }
@@ -205,20 +348,10 @@ inline void fromRawValue(const RawValue &value, FontVariant &result) {
 inline std::string toString(const FontVariant &fontVariant) {
   auto result = std::string{};
   auto separator = std::string{", "};
-  if ((int)fontVariant & (int)FontVariant::SmallCaps) {
-    result += "small-caps" + separator;
-  }
-  if ((int)fontVariant & (int)FontVariant::OldstyleNums) {
-    result += "oldstyle-nums" + separator;
-  }
-  if ((int)fontVariant & (int)FontVariant::LiningNums) {
-    result += "lining-nums" + separator;
-  }
-  if ((int)fontVariant & (int)FontVariant::TabularNums) {
-    result += "tabular-nums" + separator;
-  }
-  if ((int)fontVariant & (int)FontVariant::ProportionalNums) {
-    result += "proportional-nums" + separator;
+  for (auto const &name : detail::fontVariantNames()) {
+    if ((int)fontVariant & (int)name.value) {
+      result += name.name + separator;
+    }
   }
 
   if (!result.empty()) {
@@ -229,30 +362,18 @@ inline std::string toString(const FontVariant &fontVariant) {
 }
 
 inline void fromRawValue(const RawValue &value, TextAlignment &result) {
-  auto string = (std::string)value;
-  if (string == "auto") {
-    result = TextAlignment::Natural;
-    return;
-  }
-  if (string == "left") {
-    result = TextAlignment::Left;
-    return;
-  }
-  if (string == "center") {
-    result = TextAlignment::Center;
-    return;
+  auto name =
+      detail::findEnumName(detail::textAlignmentNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "right") {
-    result = TextAlignment::Right;
-    return;
-  }
-  if (string == "justify") {
-    result = TextAlignment::Justified;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
+/*
+ * Unlike the other enums, the debug names of `TextAlignment` are not the
+ * prop values ("auto", "justify"), so they are not taken from the table.
+ */
 inline std::string toString(const TextAlignment &textAlignment) {
   switch (textAlignment) {
     case TextAlignment::Natural:
@@ -269,319 +390,82 @@ inline std::string toString(const TextAlignment &textAlignment) {
 }
 
 inline void fromRawValue(const RawValue &value, WritingDirection &result) {
-  auto string = (std::string)value;
-  if (string == "natural") {
-    result = WritingDirection::Natural;
-    return;
-  }
-  if (string == "ltr") {
-    result = WritingDirection::LeftToRight;
-    return;
+  auto name = detail::findEnumName(
+      detail::writingDirectionNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "rtl") {
-    result = WritingDirection::RightToLeft;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(const WritingDirection &writingDirection) {
-  switch (writingDirection) {
-    case WritingDirection::Natural:
-      return "natural";
-    case WritingDirection::LeftToRight:
-      return "ltr";
-    case WritingDirection::RightToLeft:
-      return "rtl";
-  }
+  return detail::enumToString(
+      detail::writingDirectionNames(), writingDirection);
 }
 
 inline void fromRawValue(
     const RawValue &value,
     TextDecorationLineType &result) {
-  auto string = (std::string)value;
-  if (string == "none") {
-    result = TextDecorationLineType::None;
-    return;
-  }
-  if (string == "underline") {
-    result = TextDecorationLineType::Underline;
-    return;
+  auto name = detail::findEnumName(
+      detail::textDecorationLineTypeNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-
-  // TODO: remove "line-through" after deprecation
-  if (string == "strikethrough" || string == "line-through") {
-    result = TextDecorationLineType::Strikethrough;
-    return;
-  }
-
-  // TODO: remove "underline line-through" after "line-through" deprecation
-  if (string == "underline-strikethrough" ||
-      string == "underline line-through") {
-    result = TextDecorationLineType::UnderlineStrikethrough;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(
     const TextDecorationLineType &textDecorationLineType) {
-  switch (textDecorationLineType) {
-    case TextDecorationLineType::None:
-      return "none";
-    case TextDecorationLineType::Underline:
-      return "underline";
-    case TextDecorationLineType::Strikethrough:
-      return "strikethrough";
-    case TextDecorationLineType::UnderlineStrikethrough:
-      return "underline-strikethrough";
-  }
+  return detail::enumToString(
+      detail::textDecorationLineTypeNames(), textDecorationLineType);
 }
 
 inline void fromRawValue(
     const RawValue &value,
     TextDecorationLineStyle &result) {
-  auto string = (std::string)value;
-  if (string == "single") {
-    result = TextDecorationLineStyle::Single;
-    return;
+  auto name = detail::findEnumName(
+      detail::textDecorationLineStyleNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "thick") {
-    result = TextDecorationLineStyle::Thick;
-    return;
-  }
-  if (string == "double") {
-    result = TextDecorationLineStyle::Double;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(
     const TextDecorationLineStyle &textDecorationLineStyle) {
-  switch (textDecorationLineStyle) {
-    case TextDecorationLineStyle::Single:
-      return "single";
-    case TextDecorationLineStyle::Thick:
-      return "thick";
-    case TextDecorationLineStyle::Double:
-      return "double";
-  }
+  return detail::enumToString(
+      detail::textDecorationLineStyleNames(), textDecorationLineStyle);
 }
 
 inline void fromRawValue(
     const RawValue &value,
     TextDecorationLinePattern &result) {
-  auto string = (std::string)value;
-  if (string == "solid") {
-    result = TextDecorationLinePattern::Solid;
-    return;
+  auto name = detail::findEnumName(
+      detail::textDecorationLinePatternNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "dot") {
-    result = TextDecorationLinePattern::Dot;
-    return;
-  }
-  if (string == "dash") {
-    result = TextDecorationLinePattern::Dash;
-    return;
-  }
-  if (string == "dash-dot") {
-    result = TextDecorationLinePattern::DashDot;
-    return;
-  }
-  if (string == "dash-dot-dot") {
-    result = TextDecorationLinePattern::DashDotDot;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline std::string toString(
     const TextDecorationLinePattern &textDecorationLinePattern) {
-  switch (textDecorationLinePattern) {
-    case TextDecorationLinePattern::Solid:
-      return "solid";
-    case TextDecorationLinePattern::Dot:
-      return "dot";
-    case TextDecorationLinePattern::Dash:
-      return "dash";
-    case TextDecorationLinePattern::DashDot:
-      return "dash-dot";
-    case TextDecorationLinePattern::DashDotDot:
-      return "dash-dot-dot";
-  }
+  return detail::enumToString(
+      detail::textDecorationLinePatternNames(), textDecorationLinePattern);
 }
 
 inline std::string toString(const AccessibilityRole &accessibilityRole) {
-  switch (accessibilityRole) {
-    case AccessibilityRole::None:
-      return "none";
-    case AccessibilityRole::Button:
-      return "button";
-    case AccessibilityRole::Link:
-      return "link";
-    case AccessibilityRole::Search:
-      return "search";
-    case AccessibilityRole::Image:
-      return "image";
-    case AccessibilityRole::Imagebutton:
-      return "imagebutton";
-    case AccessibilityRole::Keyboardkey:
-      return "keyboardkey";
-    case AccessibilityRole::Text:
-      return "text";
-    case AccessibilityRole::Adjustable:
-      return "adjustable";
-    case AccessibilityRole::Summary:
-      return "summary";
-    case AccessibilityRole::Header:
-      return "header";
-    case AccessibilityRole::Alert:
-      return "alert";
-    case AccessibilityRole::Checkbox:
-      return "checkbox";
-    case AccessibilityRole::Combobox:
-      return "combobox";
-    case AccessibilityRole::Menu:
-      return "menu";
-    case AccessibilityRole::Menubar:
-      return "menubar";
-    case AccessibilityRole::Menuitem:
-      return "menuitem";
-    case AccessibilityRole::Progressbar:
-      return "progressbar";
-    case AccessibilityRole::Radio:
-      return "radio";
-    case AccessibilityRole::Radiogroup:
-      return "radiogroup";
-    case AccessibilityRole::Scrollbar:
-      return "scrollbar";
-    case AccessibilityRole::Spinbutton:
-      return "spinbutton";
-    case AccessibilityRole::Switch:
-      return "switch";
-    case AccessibilityRole::Tab:
-      return "tab";
-    case AccessibilityRole::Tablist:
-      return "tablist";
-    case AccessibilityRole::Timer:
-      return "timer";
-    case AccessibilityRole::Toolbar:
-      return "toolbar";
-  }
+  return detail::enumToString(
+      detail::accessibilityRoleNames(), accessibilityRole);
 }
 
 inline void fromRawValue(const RawValue &value, AccessibilityRole &result) {
-  auto string = (std::string)value;
-  if (string == "none") {
-    result = AccessibilityRole::None;
-    return;
+  auto name = detail::findEnumName(
+      detail::accessibilityRoleNames(), (std::string)value);
+  if (name == nullptr) {
+    abort();
   }
-  if (string == "button") {
-    result = AccessibilityRole::Button;
-    return;
-  }
-  if (string == "link") {
-    result = AccessibilityRole::Link;
-    return;
-  }
-  if (string == "search") {
-    result = AccessibilityRole::Search;
-    return;
-  }
-  if (string == "image") {
-    result = AccessibilityRole::Image;
-    return;
-  }
-  if (string == "imagebutton") {
-    result = AccessibilityRole::Imagebutton;
-    return;
-  }
-  if (string == "keyboardkey") {
-    result = AccessibilityRole::Keyboardkey;
-    return;
-  }
-  if (string == "text") {
-    result = AccessibilityRole::Text;
-    return;
-  }
-  if (string == "adjustable") {
-    result = AccessibilityRole::Adjustable;
-    return;
-  }
-  if (string == "summary") {
-    result = AccessibilityRole::Summary;
-    return;
-  }
-  if (string == "header") {
-    result = AccessibilityRole::Header;
-    return;
-  }
-  if (string == "alert") {
-    result = AccessibilityRole::Alert;
-    return;
-  }
-  if (string == "checkbox") {
-    result = AccessibilityRole::Checkbox;
-    return;
-  }
-  if (string == "combobox") {
-    result = AccessibilityRole::Combobox;
-    return;
-  }
-  if (string == "menu") {
-    result = AccessibilityRole::Menu;
-    return;
-  }
-  if (string == "menubar") {
-    result = AccessibilityRole::Menubar;
-    return;
-  }
-  if (string == "menuitem") {
-    result = AccessibilityRole::Menuitem;
-    return;
-  }
-  if (string == "progressbar") {
-    result = AccessibilityRole::Progressbar;
-    return;
-  }
-  if (string == "radio") {
-    result = AccessibilityRole::Radio;
-    return;
-  }
-  if (string == "radiogroup") {
-    result = AccessibilityRole::Radiogroup;
-    return;
-  }
-  if (string == "scrollbar") {
-    result = AccessibilityRole::Scrollbar;
-    return;
-  }
-  if (string == "spinbutton") {
-    result = AccessibilityRole::Spinbutton;
-    return;
-  }
-  if (string == "switch") {
-    result = AccessibilityRole::Switch;
-    return;
-  }
-  if (string == "tab") {
-    result = AccessibilityRole::Tab;
-    return;
-  }
-  if (string == "tablist") {
-    result = AccessibilityRole::Tablist;
-    return;
-  }
-  if (string == "timer") {
-    result = AccessibilityRole::Timer;
-    return;
-  }
-  if (string == "toolbar") {
-    result = AccessibilityRole::Toolbar;
-    return;
-  }
-  abort();
+  result = name->value;
 }
 
 inline ParagraphAttributes convertRawProp(
@@ -778,7 +662,7 @@ inline folly::dynamic toDynamic(const TextAttributes &textAttributes) {
 inline folly::dynamic toDynamic(const AttributedString &attributedString) {
   auto value = folly::dynamic::object();
   auto fragments = folly::dynamic::array();
-  for (auto fragment : attributedString.getFragments()) {
+  for (auto const &fragment : attributedString.getFragments()) {
     folly::dynamic dynamicFragment = folly::dynamic::object();
     dynamicFragment["string"] = fragment.string;
     if (fragment.parentShadowView.componentHandle) {
@@ -797,7 +681,7 @@ inline folly::dynamic toDynamic(const AttributedString &attributedString) {
   value("fragments", fragments);
   value(
       "hash", std::hash<ABI44_0_0facebook::ABI44_0_0React::AttributedString>{}(attributedString));
-  value("string", attributedString.getString());
+  value("string", attributedString.getCachedString());
   return value;
 }
 
@@ -808,6 +692,251 @@ inline folly::dynamic toDynamic(AttributedString::Range const &range) {
   return dynamicValue;
 }
 
+#pragma mark - MapBuffer serialization
+
+/*
+ * Keys of the MapBuffer representations below. They must be kept in sync
+ * with the Java side. Keys are written in increasing order, as
+ * `MapBufferBuilder` requires, and fields which are not set are omitted.
+ */
+
+// ParagraphAttributes
+constexpr static Key PA_KEY_MAX_NUMBER_OF_LINES = 0;
+constexpr static Key PA_KEY_ELLIPSIZE_MODE = 1;
+constexpr static Key PA_KEY_TEXT_BREAK_STRATEGY = 2;
+constexpr static Key PA_KEY_ADJUST_FONT_SIZE_TO_FIT = 3;
+constexpr static Key PA_KEY_INCLUDE_FONT_PADDING = 4;
+
+// TextAttributes
+constexpr static Key TA_KEY_FOREGROUND_COLOR = 0;
+constexpr static Key TA_KEY_BACKGROUND_COLOR = 1;
+constexpr static Key TA_KEY_OPACITY = 2;
+constexpr static Key TA_KEY_FONT_FAMILY = 3;
+constexpr static Key TA_KEY_FONT_SIZE = 4;
+constexpr static Key TA_KEY_FONT_SIZE_MULTIPLIER = 5;
+constexpr static Key TA_KEY_FONT_WEIGHT = 6;
+constexpr static Key TA_KEY_FONT_STYLE = 7;
+constexpr static Key TA_KEY_FONT_VARIANT = 8;
+constexpr static Key TA_KEY_ALLOW_FONT_SCALING = 9;
+constexpr static Key TA_KEY_LETTER_SPACING = 10;
+constexpr static Key TA_KEY_LINE_HEIGHT = 11;
+constexpr static Key TA_KEY_ALIGNMENT = 12;
+constexpr static Key TA_KEY_BEST_WRITING_DIRECTION = 13;
+constexpr static Key TA_KEY_TEXT_DECORATION_COLOR = 14;
+constexpr static Key TA_KEY_TEXT_DECORATION_LINE = 15;
+constexpr static Key TA_KEY_TEXT_DECORATION_LINE_STYLE = 16;
+constexpr static Key TA_KEY_TEXT_DECORATION_LINE_PATTERN = 17;
+constexpr static Key TA_KEY_TEXT_SHADOW_RADIUS = 18;
+constexpr static Key TA_KEY_TEXT_SHADOW_COLOR = 19;
+constexpr static Key TA_KEY_IS_HIGHLIGHTED = 20;
+constexpr static Key TA_KEY_LAYOUT_DIRECTION = 21;
+constexpr static Key TA_KEY_ACCESSIBILITY_ROLE = 22;
+
+// AttributedString
+constexpr static Key AS_KEY_HASH = 0;
+constexpr static Key AS_KEY_STRING = 1;
+constexpr static Key AS_KEY_FRAGMENTS = 2;
+constexpr static Key AS_KEY_CACHE_ID = 3;
+
+// Fragment
+constexpr static Key FR_KEY_STRING = 0;
+constexpr static Key FR_KEY_REACT_TAG = 1;
+constexpr static Key FR_KEY_IS_ATTACHMENT = 2;
+constexpr static Key FR_KEY_WIDTH = 3;
+constexpr static Key FR_KEY_HEIGHT = 4;
+constexpr static Key FR_KEY_TEXT_ATTRIBUTES = 5;
+
+// Text state (`AttributedString` + `ParagraphAttributes`)
+constexpr static Key TX_STATE_KEY_ATTRIBUTED_STRING = 0;
+constexpr static Key TX_STATE_KEY_PARAGRAPH_ATTRIBUTES = 1;
+// Used by TextInput only
+constexpr static Key TX_STATE_KEY_HASH = 2;
+constexpr static Key TX_STATE_KEY_MOST_RECENT_EVENT_COUNT = 3;
+
+/*
+ * Colors are stored as ARGB integers, the same representation
+ * `toDynamic(SharedColor)` produces.
+ */
+inline int toMapBufferColor(SharedColor const &color) {
+  return (int)toDynamic(color).asInt();
+}
+
+inline MapBuffer toMapBuffer(const ParagraphAttributes &paragraphAttributes) {
+  auto builder = MapBufferBuilder();
+  builder.putInt(
+      PA_KEY_MAX_NUMBER_OF_LINES, paragraphAttributes.maximumNumberOfLines);
+  builder.putString(
+      PA_KEY_ELLIPSIZE_MODE, toString(paragraphAttributes.ellipsizeMode));
+  builder.putString(
+      PA_KEY_TEXT_BREAK_STRATEGY,
+      toString(paragraphAttributes.textBreakStrategy));
+  builder.putBool(
+      PA_KEY_ADJUST_FONT_SIZE_TO_FIT, paragraphAttributes.adjustsFontSizeToFit);
+  builder.putBool(
+      PA_KEY_INCLUDE_FONT_PADDING, paragraphAttributes.includeFontPadding);
+
+  return builder.build();
+}
+
+inline MapBuffer toMapBuffer(const FontVariant &fontVariant) {
+  auto builder = MapBufferBuilder();
+  int index = 0;
+  if ((int)fontVariant & (int)FontVariant::SmallCaps) {
+    builder.putString(index++, "small-caps");
+  }
+  if ((int)fontVariant & (int)FontVariant::OldstyleNums) {
+    builder.putString(index++, "oldstyle-nums");
+  }
+  if ((int)fontVariant & (int)FontVariant::LiningNums) {
+    builder.putString(index++, "lining-nums");
+  }
+  if ((int)fontVariant & (int)FontVariant::TabularNums) {
+    builder.putString(index++, "tabular-nums");
+  }
+  if ((int)fontVariant & (int)FontVariant::ProportionalNums) {
+    builder.putString(index++, "proportional-nums");
+  }
+
+  return builder.build();
+}
+
+inline MapBuffer toMapBuffer(const TextAttributes &textAttributes) {
+  auto builder = MapBufferBuilder();
+  if (textAttributes.foregroundColor) {
+    builder.putInt(
+        TA_KEY_FOREGROUND_COLOR,
+        toMapBufferColor(textAttributes.foregroundColor));
+  }
+  if (textAttributes.backgroundColor) {
+    builder.putInt(
+        TA_KEY_BACKGROUND_COLOR,
+        toMapBufferColor(textAttributes.backgroundColor));
+  }
+  if (!std::isnan(textAttributes.opacity)) {
+    builder.putDouble(TA_KEY_OPACITY, textAttributes.opacity);
+  }
+  if (!textAttributes.fontFamily.empty()) {
+    builder.putString(TA_KEY_FONT_FAMILY, textAttributes.fontFamily);
+  }
+  if (!std::isnan(textAttributes.fontSize)) {
+    builder.putDouble(TA_KEY_FONT_SIZE, textAttributes.fontSize);
+  }
+  if (!std::isnan(textAttributes.fontSizeMultiplier)) {
+    builder.putDouble(
+        TA_KEY_FONT_SIZE_MULTIPLIER, textAttributes.fontSizeMultiplier);
+  }
+  if (textAttributes.fontWeight.has_value()) {
+    builder.putString(TA_KEY_FONT_WEIGHT, toString(*textAttributes.fontWeight));
+  }
+  if (textAttributes.fontStyle.has_value()) {
+    builder.putString(TA_KEY_FONT_STYLE, toString(*textAttributes.fontStyle));
+  }
+  if (textAttributes.fontVariant.has_value()) {
+    auto fontVariantMap = toMapBuffer(*textAttributes.fontVariant);
+    builder.putMapBuffer(TA_KEY_FONT_VARIANT, fontVariantMap);
+  }
+  if (textAttributes.allowFontScaling.has_value()) {
+    builder.putBool(
+        TA_KEY_ALLOW_FONT_SCALING, *textAttributes.allowFontScaling);
+  }
+  if (!std::isnan(textAttributes.letterSpacing)) {
+    builder.putDouble(TA_KEY_LETTER_SPACING, textAttributes.letterSpacing);
+  }
+  if (!std::isnan(textAttributes.lineHeight)) {
+    builder.putDouble(TA_KEY_LINE_HEIGHT, textAttributes.lineHeight);
+  }
+  if (textAttributes.alignment.has_value()) {
+    builder.putString(TA_KEY_ALIGNMENT, toString(*textAttributes.alignment));
+  }
+  if (textAttributes.baseWritingDirection.has_value()) {
+    builder.putString(
+        TA_KEY_BEST_WRITING_DIRECTION,
+        toString(*textAttributes.baseWritingDirection));
+  }
+  // Decoration
+  if (textAttributes.textDecorationColor) {
+    builder.putInt(
+        TA_KEY_TEXT_DECORATION_COLOR,
+        toMapBufferColor(textAttributes.textDecorationColor));
+  }
+  if (textAttributes.textDecorationLineType.has_value()) {
+    builder.putString(
+        TA_KEY_TEXT_DECORATION_LINE,
+        toString(*textAttributes.textDecorationLineType));
+  }
+  if (textAttributes.textDecorationLineStyle.has_value()) {
+    builder.putString(
+        TA_KEY_TEXT_DECORATION_LINE_STYLE,
+        toString(*textAttributes.textDecorationLineStyle));
+  }
+  if (textAttributes.textDecorationLinePattern.has_value()) {
+    builder.putString(
+        TA_KEY_TEXT_DECORATION_LINE_PATTERN,
+        toString(*textAttributes.textDecorationLinePattern));
+  }
+  // Shadow
+  if (!std::isnan(textAttributes.textShadowRadius)) {
+    builder.putDouble(
+        TA_KEY_TEXT_SHADOW_RADIUS, textAttributes.textShadowRadius);
+  }
+  if (textAttributes.textShadowColor) {
+    builder.putInt(
+        TA_KEY_TEXT_SHADOW_COLOR,
+        toMapBufferColor(textAttributes.textShadowColor));
+  }
+  // Special
+  if (textAttributes.isHighlighted.has_value()) {
+    builder.putBool(TA_KEY_IS_HIGHLIGHTED, *textAttributes.isHighlighted);
+  }
+  if (textAttributes.layoutDirection.has_value()) {
+    builder.putString(
+        TA_KEY_LAYOUT_DIRECTION, toString(*textAttributes.layoutDirection));
+  }
+  if (textAttributes.accessibilityRole.has_value()) {
+    builder.putString(
+        TA_KEY_ACCESSIBILITY_ROLE, toString(*textAttributes.accessibilityRole));
+  }
+  return builder.build();
+}
+
+inline MapBuffer toMapBuffer(const AttributedString::Fragment &fragment) {
+  auto builder = MapBufferBuilder();
+  builder.putString(FR_KEY_STRING, fragment.string);
+  if (fragment.parentShadowView.componentHandle) {
+    builder.putInt(FR_KEY_REACT_TAG, fragment.parentShadowView.tag);
+  }
+  if (fragment.isAttachment()) {
+    builder.putBool(FR_KEY_IS_ATTACHMENT, true);
+    builder.putDouble(
+        FR_KEY_WIDTH, fragment.parentShadowView.layoutMetrics.frame.size.width);
+    builder.putDouble(
+        FR_KEY_HEIGHT,
+        fragment.parentShadowView.layoutMetrics.frame.size.height);
+  }
+  auto textAttributesMap = toMapBuffer(fragment.textAttributes);
+  builder.putMapBuffer(FR_KEY_TEXT_ATTRIBUTES, textAttributesMap);
+  return builder.build();
+}
+
+/*
+ * Fragments are stored as a nested MapBuffer keyed by their index.
+ */
+inline MapBuffer toMapBuffer(const AttributedString &attributedString) {
+  auto fragmentsBuilder = MapBufferBuilder();
+  int index = 0;
+  for (auto const &fragment : attributedString.getFragments()) {
+    auto fragmentMap = toMapBuffer(fragment);
+    fragmentsBuilder.putMapBuffer(index++, fragmentMap);
+  }
+  auto fragmentsMap = fragmentsBuilder.build();
+
+  auto builder = MapBufferBuilder();
+  builder.putInt(AS_KEY_HASH, (int)attributedString.getHash());
+  builder.putString(AS_KEY_STRING, attributedString.getCachedString());
+  builder.putMapBuffer(AS_KEY_FRAGMENTS, fragmentsMap);
+  return builder.build();
+}
+
 #endif
 
 } // namespace ABI44_0_0React
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedStringBuilder.h>
+
+namespace ABI44_0_0facebook {
+namespace ABI44_0_0React {
+
+static AttributedString::Fragment makeFragment(std::string const &string) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = string;
+  return fragment;
+}
+
+TEST(AttributedStringBuilderTest, testAppendingAndPrepending) {
+  auto builder = AttributedStringBuilder{};
+  builder.appendFragment(makeFragment("c"));
+  builder.prependFragment(makeFragment("b"));
+  builder.prependFragment(makeFragment("a"));
+  builder.appendFragment(makeFragment(""));
+  builder.appendFragment(makeFragment("d"));
+
+  EXPECT_EQ(builder.size(), 4);
+
+  auto attributedString = builder.build();
+  EXPECT_EQ(attributedString.getString(), "abcd");
+  EXPECT_EQ(attributedString.getFragments().size(), 4);
+  EXPECT_TRUE(attributedString.getSealed());
+}
+
+TEST(AttributedStringBuilderTest, testAppendingAttributedStrings) {
+  auto inner = AttributedString{};
+  inner.appendFragment(makeFragment("b"));
+  inner.appendFragment(makeFragment("c"));
+
+  auto builder = AttributedStringBuilder{};
+  builder.appendFragment(makeFragment("d"));
+  builder.prependAttributedString(inner);
+  builder.appendAttributedString(inner);
+  builder.appendAttributedString(std::move(inner));
+
+  auto attributedString = builder.build();
+  EXPECT_EQ(attributedString.getString(), "bcdbcbc");
+  EXPECT_TRUE(inner.isEmpty());
+}
+
+TEST(AttributedStringBuilderTest, testBuilderIsReusableAfterBuild) {
+  auto builder = AttributedStringBuilder{};
+  builder.appendFragment(makeFragment("first"));
+  auto first = builder.build();
+
+  EXPECT_EQ(builder.size(), 0);
+
+  builder.appendFragment(makeFragment("second"));
+  auto second = builder.build();
+
+  EXPECT_EQ(first.getString(), "first");
+  EXPECT_EQ(second.getString(), "second");
+  EXPECT_EQ(second.getFragments().size(), 1);
+}
+
+TEST(AttributedStringBuilderTest, testRecycledFragmentsAreReused) {
+  auto longString = std::string(100, 'a');
+
+  auto builder = AttributedStringBuilder{};
+  builder.appendFragment(makeFragment(longString));
+  builder.appendFragment(makeFragment(longString));
+  auto recycled = builder.buildUnsealed();
+
+  builder.recycle(std::move(recycled));
+  EXPECT_TRUE(recycled.isEmpty());
+  EXPECT_EQ(builder.size(), 0);
+
+  // Copied fragments take over the string buffers of recycled ones.
+  auto fragment = makeFragment("x");
+  builder.appendFragment(fragment);
+  builder.prependFragment(fragment);
+  auto attributedString = builder.build();
+
+  EXPECT_EQ(attributedString.getString(), "xx");
+  for (auto const &builtFragment : attributedString.getFragments()) {
+    EXPECT_EQ(builtFragment.string, "x");
+    EXPECT_GE(builtFragment.string.capacity(), longString.size());
+  }
+}
+
+TEST(AttributedStringBuilderTest, testRecycledFragmentsAreFullyOverwritten) {
+  auto builder = AttributedStringBuilder{};
+  auto styledFragment = makeFragment("styled");
+  styledFragment.textAttributes.fontSize = 20;
+  styledFragment.parentShadowView.tag = 42;
+  builder.appendFragment(styledFragment);
+  builder.recycle(builder.buildUnsealed());
+
+  auto fragment = makeFragment("plain");
+  builder.appendFragment(fragment);
+  auto attributedString = builder.build();
+
+  ASSERT_EQ(attributedString.getFragments().size(), 1);
+  EXPECT_TRUE(attributedString.getFragments()[0] == fragment);
+}
+
+TEST(AttributedStringBuilderTest, testRecyclingAFreshString) {
+  auto builder = AttributedStringBuilder{};
+  builder.recycle(AttributedString{});
+  builder.recycle(builder.buildUnsealed());
+
+  builder.appendFragment(makeFragment("a"));
+  auto attributedString = builder.build();
+  EXPECT_EQ(attributedString.getString(), "a");
+}
+
+} // namespace ABI44_0_0React
+} // namespace ABI44_0_0facebook
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedString.h>
+
+namespace ABI44_0_0facebook {
+namespace ABI44_0_0React {
+
+static AttributedString::Fragment makeFragment(
+    std::string const &string,
+    Float fontSize = 14) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = string;
+  fragment.textAttributes.fontSize = fontSize;
+  return fragment;
+}
+
+static AttributedString makeAttributedString(
+    std::vector<std::string> const &strings) {
+  auto attributedString = AttributedString{};
+  for (auto const &string : strings) {
+    attributedString.appendFragment(makeFragment(string));
+  }
+  return attributedString;
+}
+
+#pragma mark - Equality and hashing
+
+TEST(AttributedStringTest, testEqualStringsHaveEqualHashes) {
+  auto lhs = makeAttributedString({"Hello ", "world"});
+  auto rhs = makeAttributedString({"Hello ", "world"});
+
+  EXPECT_EQ(lhs.getHash(), rhs.getHash());
+  EXPECT_TRUE(lhs == rhs);
+
+  // Parent shadow view fields ignored by equality must not affect the hash.
+  auto fragment = makeFragment("!");
+  fragment.parentShadowView.componentName = "Text";
+  lhs.appendFragment(fragment);
+  rhs.appendFragment(makeFragment("!"));
+
+  EXPECT_EQ(lhs.getHash(), rhs.getHash());
+  EXPECT_TRUE(lhs == rhs);
+}
+
+TEST(AttributedStringTest, testMutationInvalidatesMemoizedHash) {
+  auto attributedString = makeAttributedString({"Hello"});
+  auto hash = attributedString.getHash();
+  attributedString.appendFragment(makeFragment(" world"));
+
+  EXPECT_NE(attributedString.getHash(), hash);
+  EXPECT_FALSE(attributedString == makeAttributedString({"Hello"}));
+  EXPECT_EQ(attributedString.getString(), "Hello world");
+}
+
+#pragma mark - Diff and edits
+
+TEST(AttributedStringTest, testDiffOfEqualStringsIsEmpty) {
+  auto lhs = makeAttributedString({"Hello ", "world"});
+  auto rhs = makeAttributedString({"Hello ", "world"});
+
+  EXPECT_TRUE(lhs.diff(rhs).empty());
+  EXPECT_TRUE(lhs.diff(lhs).empty());
+}
+
+TEST(AttributedStringTest, testDiffNarrowsStringUpdates) {
+  auto lhs = makeAttributedString({"Hello ", "world"});
+  auto rhs = makeAttributedString({"Hello ", "wonderful world"});
+
+  auto edits = lhs.diff(rhs);
+  ASSERT_EQ(edits.size(), 1);
+  EXPECT_EQ(edits[0].type, AttributedString::Edit::Type::UpdateString);
+  EXPECT_EQ(edits[0].index, 1);
+  EXPECT_EQ(edits[0].range.location, 2);
+  EXPECT_EQ(edits[0].range.length, 0);
+  EXPECT_EQ(edits[0].string, "nderful wo");
+
+  lhs.applyEdits(edits);
+  EXPECT_TRUE(lhs == rhs);
+  EXPECT_EQ(lhs.getString(), "Hello wonderful world");
+}
+
+TEST(AttributedStringTest, testDiffKeepsStringUpdatesOnCodePoints) {
+  // "é" and "è" share their leading UTF-8 byte.
+  auto lhs = makeAttributedString({"caf\xC3\xA9"});
+  auto rhs = makeAttributedString({"caf\xC3\xA8"});
+
+  auto edits = lhs.diff(rhs);
+  ASSERT_EQ(edits.size(), 1);
+  EXPECT_EQ(edits[0].type, AttributedString::Edit::Type::UpdateString);
+  EXPECT_EQ(edits[0].range.location, 3);
+  EXPECT_EQ(edits[0].range.length, 2);
+  EXPECT_EQ(edits[0].string, "\xC3\xA8");
+
+  lhs.applyEdits(edits);
+  EXPECT_TRUE(lhs == rhs);
+}
+
+TEST(AttributedStringTest, testDiffInsertsAndRemovesFragments) {
+  auto lhs = makeAttributedString({"a", "b", "c"});
+  auto removed = makeAttributedString({"a", "c"});
+  auto inserted = makeAttributedString({"a", "b", "x", "y", "c"});
+
+  auto removingEdits = lhs.diff(removed);
+  ASSERT_EQ(removingEdits.size(), 1);
+  EXPECT_EQ(removingEdits[0].type, AttributedString::Edit::Type::Remove);
+  EXPECT_EQ(removingEdits[0].index, 1);
+
+  auto insertingEdits = lhs.diff(inserted);
+  ASSERT_EQ(insertingEdits.size(), 2);
+  EXPECT_EQ(insertingEdits[0].type, AttributedString::Edit::Type::Insert);
+  EXPECT_EQ(insertingEdits[0].index, 2);
+  EXPECT_EQ(insertingEdits[1].type, AttributedString::Edit::Type::Insert);
+  EXPECT_EQ(insertingEdits[1].index, 3);
+
+  auto copy = lhs;
+  copy.applyEdits(removingEdits);
+  EXPECT_TRUE(copy == removed);
+
+  copy = lhs;
+  copy.applyEdits(insertingEdits);
+  EXPECT_TRUE(copy == inserted);
+}
+
+TEST(AttributedStringTest, testDiffUpdatesFragmentsWithChangedAttributes) {
+  auto lhs = makeAttributedString({"a", "b"});
+  auto rhs = AttributedString{};
+  rhs.appendFragment(makeFragment("a"));
+  rhs.appendFragment(makeFragment("b", 20));
+
+  auto edits = lhs.diff(rhs);
+  ASSERT_EQ(edits.size(), 1);
+  EXPECT_EQ(edits[0].type, AttributedString::Edit::Type::Update);
+  EXPECT_EQ(edits[0].index, 1);
+
+  lhs.applyEdits(edits);
+  EXPECT_TRUE(lhs == rhs);
+  EXPECT_EQ(lhs.getFragments()[1].textAttributes.fontSize, 20);
+}
+
+#pragma mark - UTF-16 offsets
+
+TEST(AttributedStringTest, testUTF16OffsetsOfASCIIString) {
+  auto attributedString = makeAttributedString({"Hello ", "world"});
+
+  EXPECT_EQ(attributedString.getUTF16Length(), 11);
+  EXPECT_EQ(attributedString.getUTF16Offset(7), 7);
+  EXPECT_EQ(attributedString.getUTF8Offset(7), 7);
+}
+
+TEST(AttributedStringTest, testUTF16OffsetsAcrossFragments) {
+  // "é" is two UTF-8 code units and one UTF-16 code unit.
+  auto attributedString = makeAttributedString({"caf\xC3\xA9", " ", "ol\xC3\xA9"});
+
+  EXPECT_EQ(attributedString.getCachedString().size(), 10);
+  EXPECT_EQ(attributedString.getUTF16Length(), 8);
+
+  // Start of the second and the third fragment.
+  EXPECT_EQ(attributedString.getUTF16Offset(5), 4);
+  EXPECT_EQ(attributedString.getUTF16Offset(6), 5);
+  EXPECT_EQ(attributedString.getUTF8Offset(4), 5);
+  EXPECT_EQ(attributedString.getUTF8Offset(5), 6);
+
+  auto range = attributedString.getUTF16Range({6, 4});
+  EXPECT_EQ(range.location, 5);
+  EXPECT_EQ(range.length, 3);
+}
+
+TEST(AttributedStringTest, testUTF16OffsetsOfSurrogatePairs) {
+  // U+1F600 is four UTF-8 code units and a UTF-16 surrogate pair.
+  auto attributedString = makeAttributedString({"a", "\xF0\x9F\x98\x80", "b"});
+
+  EXPECT_EQ(attributedString.getUTF16Length(), 4);
+  EXPECT_EQ(attributedString.getUTF16Offset(1), 1);
+  EXPECT_EQ(attributedString.getUTF16Offset(5), 3);
+  EXPECT_EQ(attributedString.getUTF8Offset(1), 1);
+  EXPECT_EQ(attributedString.getUTF8Offset(3), 5);
+
+  // An offset between the two halves of the pair is rounded up.
+  EXPECT_EQ(attributedString.getUTF8Offset(2), 5);
+}
+
+TEST(AttributedStringTest, testUTF16OffsetsAtCheckpointBoundaries) {
+  // The two-byte code point straddles the first checkpoint (byte 64).
+  auto attributedString =
+      makeAttributedString({std::string(63, 'a'), "\xC3\xA9", "b"});
+
+  EXPECT_EQ(attributedString.getUTF16Length(), 65);
+  EXPECT_EQ(attributedString.getUTF16Offset(63), 63);
+  EXPECT_EQ(attributedString.getUTF16Offset(65), 64);
+  EXPECT_EQ(attributedString.getUTF8Offset(63), 63);
+  EXPECT_EQ(attributedString.getUTF8Offset(64), 65);
+  EXPECT_EQ(attributedString.getUTF8Offset(65), 66);
+}
+
+TEST(AttributedStringTest, testUTF16OffsetsAtTheEndOfACheckpoint) {
+  // 64 bytes, the end of the string falls on a checkpoint.
+  auto string = std::string{};
+  for (auto i = 0; i < 32; i++) {
+    string += "\xC3\xA9";
+  }
+  auto attributedString = makeAttributedString({string});
+
+  EXPECT_EQ(attributedString.getUTF16Length(), 32);
+  EXPECT_EQ(attributedString.getUTF16Offset(64), 32);
+  EXPECT_EQ(attributedString.getUTF16Offset(100), 32);
+  EXPECT_EQ(attributedString.getUTF8Offset(32), 64);
+
+  auto range = attributedString.getUTF16Range({62, 2});
+  EXPECT_EQ(range.location, 31);
+  EXPECT_EQ(range.length, 1);
+}
+
+TEST(AttributedStringTest, testUTF16OffsetsAreClamped) {
+  auto attributedString = makeAttributedString({"ol\xC3\xA9"});
+
+  EXPECT_EQ(attributedString.getUTF16Offset(-1), 0);
+  EXPECT_EQ(attributedString.getUTF16Offset(100), 3);
+  EXPECT_EQ(attributedString.getUTF8Offset(-1), 0);
+  EXPECT_EQ(attributedString.getUTF8Offset(100), 4);
+  EXPECT_EQ(AttributedString{}.getUTF16Length(), 0);
+}
+
+TEST(AttributedStringTest, testMutationInvalidatesUTF16Index) {
+  auto attributedString = makeAttributedString({"abc"});
+  EXPECT_EQ(attributedString.getUTF16Length(), 3);
+
+  attributedString.appendFragment(makeFragment("\xF0\x9F\x98\x80"));
+  EXPECT_EQ(attributedString.getUTF16Length(), 5);
+  EXPECT_EQ(attributedString.getUTF8Offset(5), 7);
+}
+
+TEST(AttributedStringTest, testCopiesAndMovesKeepTheUTF16Index) {
+  auto attributedString = makeAttributedString({"caf\xC3\xA9", "!"});
+  EXPECT_EQ(attributedString.getUTF16Length(), 5);
+
+  auto copy = attributedString;
+  EXPECT_EQ(copy.getUTF16Offset(5), 4);
+  EXPECT_EQ(copy.getCachedString(), "caf\xC3\xA9!");
+
+  auto moved = std::move(attributedString);
+  EXPECT_EQ(moved.getUTF8Offset(4), 5);
+
+  // Mutating a copy does not affect the index of the original.
+  copy.appendFragment(makeFragment("\xF0\x9F\x98\x80"));
+  EXPECT_EQ(copy.getUTF16Length(), 7);
+  EXPECT_EQ(moved.getUTF16Length(), 5);
+}
+
+} // namespace ABI44_0_0React
+} // namespace ABI44_0_0facebook
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/*
+ * Microbenchmarks of the attributedstring module.
+ * Every benchmark runs over strings of 1, 10 and 1000 fragments, shared and
+ * distinct styles, and ASCII and CJK/emoji text; the arguments are
+ * `{fragments, distinctStyles, script}`.
+ *
+ * Run with `--benchmark_format=json` (or `--benchmark_out=<file>
+ * --benchmark_out_format=json`) to get machine-readable results that can be
+ * compared between revisions, or pass such a file as `--baseline=<file>` to
+ * fail on regressions (see `ABI44_0_0BenchmarkSupport.cpp`).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedString.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedStringBuilder.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/TextAttributes.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/conversions.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/graphics/Color.h>
+
+namespace ABI44_0_0facebook {
+namespace ABI44_0_0React {
+
+enum class Script { ASCII = 0, CJKAndEmoji = 1 };
+
+static std::string fragmentString(Script script, int index) {
+  switch (script) {
+    case Script::ASCII:
+      return "The quick brown fox jumps over the lazy dog " +
+          std::to_string(index);
+    case Script::CJKAndEmoji:
+      return u8"敏捷的棕色狐狸跳过了懒狗 😀👍🏽 " + std::to_string(index);
+  }
+  return {};
+}
+
+static TextAttributes textAttributes(bool distinct, int index) {
+  auto textAttributes = TextAttributes::defaultTextAttributes();
+  textAttributes.fontFamily = "Helvetica";
+  textAttributes.fontWeight = FontWeight::Bold;
+  textAttributes.lineHeight = 20;
+  textAttributes.fontSize = distinct ? 10 + index % 64 : 14;
+  return textAttributes;
+}
+
+static AttributedString::Fragment
+makeFragment(Script script, bool distinctStyles, int index) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = fragmentString(script, index);
+  fragment.textAttributes = textAttributes(distinctStyles, index);
+  return fragment;
+}
+
+static AttributedString makeAttributedString(benchmark::State const &state) {
+  auto count = (int)state.range(0);
+  auto distinctStyles = state.range(1) != 0;
+  auto script = (Script)state.range(2);
+
+  auto attributedString = AttributedString{};
+  for (int i = 0; i < count; i++) {
+    attributedString.appendFragment(makeFragment(script, distinctStyles, i));
+  }
+  return attributedString;
+}
+
+static void arguments(benchmark::internal::Benchmark *benchmark) {
+  for (auto count : {1, 10, 1000}) {
+    for (auto distinctStyles : {0, 1}) {
+      for (auto script : {0, 1}) {
+        benchmark->Args({count, distinctStyles, script});
+      }
+    }
+  }
+  benchmark->ArgNames({"fragments", "distinctStyles", "script"});
+}
+
+static void BM_TextAttributesApply(benchmark::State &state) {
+  auto count = (int)state.range(0);
+  auto distinctStyles = state.range(1) != 0;
+
+  auto styles = std::vector<TextAttributes>{};
+  for (int i = 0; i < count; i++) {
+    styles.push_back(textAttributes(distinctStyles, i));
+  }
+
+  for (auto _ : state) {
+    auto result = TextAttributes::defaultTextAttributes();
+    for (auto const &style : styles) {
+      result.apply(style);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TextAttributesApply)->Apply(arguments);
+
+static void BM_AttributedStringBuild(benchmark::State &state) {
+  auto count = (int)state.range(0);
+  auto distinctStyles = state.range(1) != 0;
+  auto script = (Script)state.range(2);
+
+  auto fragments = std::vector<AttributedString::Fragment>{};
+  for (int i = 0; i < count; i++) {
+    fragments.push_back(makeFragment(script, distinctStyles, i));
+  }
+
+  for (auto _ : state) {
+    auto builder = AttributedStringBuilder{(size_t)count};
+    for (auto const &fragment : fragments) {
+      builder.appendFragment(fragment);
+    }
+    auto attributedString = builder.build();
+    benchmark::DoNotOptimize(attributedString);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_AttributedStringBuild)->Apply(arguments);
+
+static void BM_AttributedStringHash(benchmark::State &state) {
+  auto attributedString = makeAttributedString(state);
+
+  for (auto _ : state) {
+    // A mutation drops the memoized hash, so this measures hashing itself.
+    state.PauseTiming();
+    attributedString.getFragments();
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(std::hash<AttributedString>{}(attributedString));
+  }
+}
+BENCHMARK(BM_AttributedStringHash)->Apply(arguments);
+
+static void BM_AttributedStringMemoizedHash(benchmark::State &state) {
+  auto attributedString = makeAttributedString(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::hash<AttributedString>{}(attributedString));
+  }
+}
+BENCHMARK(BM_AttributedStringMemoizedHash)->Apply(arguments);
+
+static void BM_AttributedStringGetString(benchmark::State &state) {
+  auto attributedString = makeAttributedString(state);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    attributedString.getFragments();
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(attributedString.getString());
+  }
+}
+BENCHMARK(BM_AttributedStringGetString)->Apply(arguments);
+
+static void BM_AttributedStringUTF16Offset(benchmark::State &state) {
+  auto attributedString = makeAttributedString(state);
+  auto length = (int)attributedString.getCachedString().size();
+
+  auto offset = 0;
+  for (auto _ : state) {
+    offset = (offset + 7919) % (length + 1);
+    benchmark::DoNotOptimize(attributedString.getUTF16Offset(offset));
+  }
+}
+BENCHMARK(BM_AttributedStringUTF16Offset)->Apply(arguments);
+
+static void BM_AttributedStringCompareTextAttributesWithoutFrame(
+    benchmark::State &state) {
+  auto lhs = makeAttributedString(state);
+  auto rhs = makeAttributedString(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs.compareTextAttributesWithoutFrame(rhs));
+  }
+}
+BENCHMARK(BM_AttributedStringCompareTextAttributesWithoutFrame)
+    ->Apply(arguments);
+
+static void BM_AttributedStringEquality(benchmark::State &state) {
+  auto lhs = makeAttributedString(state);
+  auto rhs = makeAttributedString(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+}
+BENCHMARK(BM_AttributedStringEquality)->Apply(arguments);
+
+static void BM_AttributedStringDiff(benchmark::State &state) {
+  auto lhs = makeAttributedString(state);
+  auto rhs = lhs;
+  auto &fragments = rhs.getFragments();
+  fragments[fragments.size() / 2].string += "!";
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs.diff(rhs));
+  }
+}
+BENCHMARK(BM_AttributedStringDiff)->Apply(arguments);
+
+#ifdef ANDROID
+static void BM_AttributedStringToDynamic(benchmark::State &state) {
+  auto attributedString = makeAttributedString(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toDynamic(attributedString));
+  }
+}
+BENCHMARK(BM_AttributedStringToDynamic)->Apply(arguments);
+
+static void BM_AttributedStringToMapBuffer(benchmark::State &state) {
+  auto attributedString = makeAttributedString(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toMapBuffer(attributedString));
+  }
+}
+BENCHMARK(BM_AttributedStringToMapBuffer)->Apply(arguments);
+#endif
+
+} // namespace ABI44_0_0React
+} // namespace ABI44_0_0facebook
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/*
+ * End-to-end scenarios of building attributed strings per keystroke, the way
+ * `BaseTextShadowNode::buildAttributedString` does on every layout pass: the
+ * text attributes of every span are the ones of the text with the span's own
+ * applied, and every raw text becomes a fragment.
+ * Every benchmark reports latency percentiles of single keystrokes and the
+ * number of allocations per keystroke (see `IterationRecorder`).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedString.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/AttributedStringBuilder.h>
+#include <ABI44_0_0React/ABI44_0_0renderer/attributedstring/TextAttributes.h>
+
+#include "ABI44_0_0BenchmarkSupport.h"
+
+namespace ABI44_0_0facebook {
+namespace ABI44_0_0React {
+
+struct Span {
+  TextAttributes textAttributes;
+  std::string text;
+};
+
+static AttributedString buildAttributedString(
+    TextAttributes const &baseTextAttributes,
+    std::vector<Span> const &spans) {
+  auto builder = AttributedStringBuilder{spans.size()};
+  for (auto const &span : spans) {
+    auto fragment = AttributedString::Fragment{};
+    fragment.textAttributes = baseTextAttributes;
+    fragment.textAttributes.apply(span.textAttributes);
+    fragment.string = span.text;
+    builder.appendFragment(std::move(fragment));
+  }
+  // The scenarios move the strings around, which sealed strings forbid.
+  return builder.buildUnsealed();
+}
+
+static TextAttributes baseTextAttributes() {
+  auto textAttributes = TextAttributes::defaultTextAttributes();
+  textAttributes.fontFamily = "Helvetica";
+  textAttributes.fontSize = 14;
+  textAttributes.lineHeight = 20;
+  return textAttributes;
+}
+
+static TextAttributes spanTextAttributes(int style) {
+  auto textAttributes = TextAttributes{};
+  switch (style % 3) {
+    case 0:
+      textAttributes.fontWeight = FontWeight::Bold;
+      break;
+    case 1:
+      textAttributes.fontStyle = FontStyle::Italic;
+      break;
+    default:
+      textAttributes.fontSize = 12;
+      break;
+  }
+  return textAttributes;
+}
+
+/*
+ * A form of 50 inputs, each made of a label, a value and a hint. A keystroke
+ * appends a character to the value of one of them, whose string is rebuilt
+ * and compared with the previous one; the others are looked up by hash, as
+ * the measurement cache does.
+ */
+static void BM_Form50InputsKeystroke(benchmark::State &state) {
+  constexpr auto kInputCount = 50;
+
+  auto base = baseTextAttributes();
+  auto inputs = std::vector<std::vector<Span>>{};
+  auto strings = std::vector<AttributedString>{};
+  for (int i = 0; i < kInputCount; i++) {
+    inputs.push_back({
+        {spanTextAttributes(0), "Field " + std::to_string(i) + ": "},
+        {spanTextAttributes(1), "value"},
+        {spanTextAttributes(2), " (required)"},
+    });
+    strings.push_back(buildAttributedString(base, inputs.back()));
+  }
+
+  auto recorder = IterationRecorder{state};
+  auto keystroke = 0;
+  for (auto _ : state) {
+    auto index = keystroke++ % kInputCount;
+
+    recorder.begin();
+    inputs[index][1].text += 'a';
+    auto attributedString = buildAttributedString(base, inputs[index]);
+    benchmark::DoNotOptimize(attributedString == strings[index]);
+    strings[index] = std::move(attributedString);
+
+    auto hash = size_t{0};
+    for (auto const &string : strings) {
+      hash ^= std::hash<AttributedString>{}(string);
+    }
+    benchmark::DoNotOptimize(hash);
+    recorder.end();
+  }
+}
+BENCHMARK(BM_Form50InputsKeystroke)->Apply(scenarioBenchmark);
+
+/*
+ * An editor of 5,000 highlighted lines. A keystroke appends a character to
+ * one line; the whole string is rebuilt, flattened for measurement, hashed
+ * and diffed with the previous one.
+ */
+static void BM_Editor5000LinesKeystroke(benchmark::State &state) {
+  constexpr auto kLineCount = 5000;
+
+  auto base = baseTextAttributes();
+  auto spans = std::vector<Span>{};
+  for (int i = 0; i < kLineCount; i++) {
+    spans.push_back(
+        {spanTextAttributes(i),
+         "let value" + std::to_string(i) + " = compute(" + std::to_string(i) +
+             ");\n"});
+  }
+  auto previous = buildAttributedString(base, spans);
+
+  auto recorder = IterationRecorder{state};
+  auto keystroke = 0;
+  for (auto _ : state) {
+    auto &line = spans[(keystroke++ * 7919) % kLineCount].text;
+
+    recorder.begin();
+    line.insert(line.size() - 1, 1, 'x');
+    auto attributedString = buildAttributedString(base, spans);
+    benchmark::DoNotOptimize(attributedString.getString());
+    benchmark::DoNotOptimize(std::hash<AttributedString>{}(attributedString));
+    benchmark::DoNotOptimize(previous.diff(attributedString));
+    previous = std::move(attributedString);
+    recorder.end();
+  }
+}
+BENCHMARK(BM_Editor5000LinesKeystroke)->Apply(scenarioBenchmark);
+
+} // namespace ABI44_0_0React
+} // namespace ABI44_0_0facebook
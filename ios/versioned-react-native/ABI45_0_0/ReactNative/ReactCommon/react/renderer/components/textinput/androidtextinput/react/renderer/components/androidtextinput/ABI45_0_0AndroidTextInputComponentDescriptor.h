@@ -10,11 +10,17 @@
 #include "ABI45_0_0AndroidTextInputShadowNode.h"
 
 #include <fbjni/fbjni.h>
+#include <ABI45_0_0cxxreact/ABI45_0_0SystraceSection.h>
+
+#include <cmath>
+#include <mutex>
+#include <shared_mutex>
 
 #include <ABI45_0_0yoga/ABI45_0_0CompactValue.h>
 #include <ABI45_0_0yoga/ABI45_0_0YGEnums.h>
 #include <ABI45_0_0yoga/ABI45_0_0YGValue.h>
 
+#include <ABI45_0_0React/ABI45_0_0config/ReactNativeConfig.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/core/ConcreteComponentDescriptor.h>
 
 namespace ABI45_0_0facebook {
@@ -32,43 +38,27 @@ class AndroidTextInputComponentDescriptor final
     // Every single `AndroidTextInputShadowNode` will have a reference to
     // a shared `TextLayoutManager`.
     textLayoutManager_ = std::make_shared<TextLayoutManager>(contextContainer_);
+    measurementCache_ = std::make_shared<AndroidTextInputMeasurementCache>();
+
+    auto reactNativeConfig = contextContainer_
+        ? contextContainer_->find<std::shared_ptr<ReactNativeConfig const>>(
+              "ReactNativeConfig")
+        : butter::optional<std::shared_ptr<ReactNativeConfig const>>{};
+    paragraphChunkedMeasurementEnabled_ = reactNativeConfig &&
+        *reactNativeConfig &&
+        (*reactNativeConfig)
+            ->getBool(
+                "react_fabric:enable_text_input_paragraph_measurement_android");
+    telemetryEnabled_ = reactNativeConfig && *reactNativeConfig &&
+        (*reactNativeConfig)
+            ->getBool("react_fabric:enable_text_input_telemetry_android");
   }
 
   virtual State::Shared createInitialState(
       ShadowNodeFragment const &fragment,
       ShadowNodeFamily::Shared const &family) const override {
     int surfaceId = family->getSurfaceId();
-
-    ABI45_0_0YGStyle::Edges theme;
-    // TODO: figure out RTL/start/end/left/right stuff here
-    if (surfaceIdToThemePaddingMap_.find(surfaceId) !=
-        surfaceIdToThemePaddingMap_.end()) {
-      theme = surfaceIdToThemePaddingMap_[surfaceId];
-    } else {
-      const jni::global_ref<jobject> &fabricUIManager =
-          contextContainer_->at<jni::global_ref<jobject>>("FabricUIManager");
-
-      auto env = jni::Environment::current();
-      auto defaultTextInputPaddingArray = env->NewFloatArray(4);
-      static auto getThemeData =
-          jni::findClassStatic(UIManagerJavaDescriptor)
-              ->getMethod<jboolean(jint, jfloatArray)>("getThemeData");
-
-      if (getThemeData(
-              fabricUIManager, surfaceId, defaultTextInputPaddingArray)) {
-        jfloat *defaultTextInputPadding =
-            env->GetFloatArrayElements(defaultTextInputPaddingArray, 0);
-        theme[ABI45_0_0YGEdgeStart] = (ABI45_0_0YGValue){defaultTextInputPadding[0], ABI45_0_0YGUnitPoint};
-        theme[ABI45_0_0YGEdgeEnd] = (ABI45_0_0YGValue){defaultTextInputPadding[1], ABI45_0_0YGUnitPoint};
-        theme[ABI45_0_0YGEdgeTop] = (ABI45_0_0YGValue){defaultTextInputPadding[2], ABI45_0_0YGUnitPoint};
-        theme[ABI45_0_0YGEdgeBottom] =
-            (ABI45_0_0YGValue){defaultTextInputPadding[3], ABI45_0_0YGUnitPoint};
-        surfaceIdToThemePaddingMap_.emplace(std::make_pair(surfaceId, theme));
-        env->ReleaseFloatArrayElements(
-            defaultTextInputPaddingArray, defaultTextInputPadding, JNI_ABORT);
-      }
-      env->DeleteLocalRef(defaultTextInputPaddingArray);
-    }
+    auto theme = getThemePadding(surfaceId);
 
     return std::make_shared<AndroidTextInputShadowNode::ConcreteState>(
         std::make_shared<AndroidTextInputState const>(AndroidTextInputState(
@@ -93,14 +83,37 @@ class AndroidTextInputComponentDescriptor final
     // `ParagraphShadowNode` uses `TextLayoutManager` to measure text content
     // and communicate text rendering metrics to mounting layer.
     textInputShadowNode->setTextLayoutManager(textLayoutManager_);
+    textInputShadowNode->setMeasurementCache(measurementCache_);
+
+    // Clones inherit the paragraph cache and counters of their source node,
+    // so the (locked) lookups happen once per node family.
+    if (paragraphChunkedMeasurementEnabled_ &&
+        !textInputShadowNode->getParagraphCache()) {
+      textInputShadowNode->setParagraphCache(
+          measurementCache_->getParagraphCache(
+              textInputShadowNode->getSurfaceId()));
+    }
+    if (telemetryEnabled_ && !textInputShadowNode->getTelemetry()) {
+      textInputShadowNode->setTelemetry(
+          AndroidTextInputTelemetry::shared().getSurfaceCounters(
+              textInputShadowNode->getSurfaceId()));
+    }
 
     textInputShadowNode->setContextContainer(
         const_cast<ContextContainer *>(getContextContainer().get()));
 
-    int surfaceId = textInputShadowNode->getSurfaceId();
-    if (surfaceIdToThemePaddingMap_.find(surfaceId) !=
-        surfaceIdToThemePaddingMap_.end()) {
-      ABI45_0_0YGStyle::Edges theme = surfaceIdToThemePaddingMap_[surfaceId];
+    // Theme padding is resolved once per surface (see `getThemePadding`) and
+    // is carried by the state, so no shared data is accessed here.
+    auto const &state = textInputShadowNode->getStateData();
+    if (!std::isnan(state.defaultThemePaddingStart) ||
+        !std::isnan(state.defaultThemePaddingEnd) ||
+        !std::isnan(state.defaultThemePaddingTop) ||
+        !std::isnan(state.defaultThemePaddingBottom)) {
+      ABI45_0_0YGStyle::Edges theme;
+      theme[ABI45_0_0YGEdgeStart] = themePaddingValue(state.defaultThemePaddingStart);
+      theme[ABI45_0_0YGEdgeEnd] = themePaddingValue(state.defaultThemePaddingEnd);
+      theme[ABI45_0_0YGEdgeTop] = themePaddingValue(state.defaultThemePaddingTop);
+      theme[ABI45_0_0YGEdgeBottom] = themePaddingValue(state.defaultThemePaddingBottom);
 
       // Override padding
       // Node is still unsealed during adoption, before layout is complete
@@ -155,10 +168,19 @@ class AndroidTextInputComponentDescriptor final
         result[ABI45_0_0YGEdgeEnd] = ABI45_0_0YGValueUndefined;
       }
 
-      // Note that this is expensive: on every adopt, we need to set the Yoga
-      // props again, which normally only happens during prop parsing. Every
-      // commit, state update, etc, will incur this cost.
-      if (changedPadding) {
+      // Setting Yoga props again is expensive (it normally only happens
+      // during prop parsing). Props objects are shared between revisions of
+      // the node, so once the theme padding was merged into one, the result
+      // equals the current padding and there is nothing to do; this only
+      // runs when props (or the theme) actually change.
+      // Only these edges of `result` can differ from the current padding.
+      auto const &padding =
+          textInputShadowNode->getConcreteProps().yogaStyle.padding();
+      if (changedPadding &&
+          (result[ABI45_0_0YGEdgeStart] != padding[ABI45_0_0YGEdgeStart] ||
+           result[ABI45_0_0YGEdgeEnd] != padding[ABI45_0_0YGEdgeEnd] ||
+           result[ABI45_0_0YGEdgeTop] != padding[ABI45_0_0YGEdgeTop] ||
+           result[ABI45_0_0YGEdgeBottom] != padding[ABI45_0_0YGEdgeBottom])) {
         // Set new props on node
         const_cast<AndroidTextInputProps &>(
             textInputShadowNode->getConcreteProps())
@@ -168,18 +190,94 @@ class AndroidTextInputComponentDescriptor final
       }
     }
 
-    textInputShadowNode->dirtyLayout();
+    // Measured content depends on props, children and state only; clones
+    // which keep all of them (e.g. ones created just to lay out the node
+    // again) do not need to be re-measured.
+    if (textInputShadowNode->getContentMightHaveChanged()) {
+      textInputShadowNode->dirtyLayout();
+    }
     textInputShadowNode->enableMeasurement();
 
     ConcreteComponentDescriptor::adopt(shadowNode);
   }
 
  private:
+  static ABI45_0_0YGValue themePaddingValue(float value) {
+    return std::isnan(value) ? ABI45_0_0YGValueUndefined
+                             : (ABI45_0_0YGValue){value, ABI45_0_0YGUnitPoint};
+  }
+
+  /*
+   * Returns the default (theme) padding of text inputs on the surface.
+   * The padding is requested from Java (via JNI) the first time it is needed
+   * on a surface and then reused; commits on different threads can call this
+   * concurrently.
+   * It is not requested ahead of time: component descriptors are not told
+   * when a surface starts, so the first text input of a surface still pays
+   * for the JNI call.
+   */
+  ABI45_0_0YGStyle::Edges getThemePadding(int surfaceId) const {
+    {
+      std::shared_lock<std::shared_mutex> lock(themePaddingMutex_);
+      auto iterator = surfaceIdToThemePaddingMap_.find(surfaceId);
+      if (iterator != surfaceIdToThemePaddingMap_.end()) {
+        return iterator->second;
+      }
+    }
+
+    ABI45_0_0YGStyle::Edges theme;
+    // TODO: figure out RTL/start/end/left/right stuff here
+    const jni::global_ref<jobject> &fabricUIManager =
+        contextContainer_->at<jni::global_ref<jobject>>("FabricUIManager");
+
+    auto env = jni::Environment::current();
+    auto defaultTextInputPaddingArray = env->NewFloatArray(4);
+    static auto getThemeData =
+        jni::findClassStatic(UIManagerJavaDescriptor)
+            ->getMethod<jboolean(jint, jfloatArray)>("getThemeData");
+
+    auto themeDataRequested = [&]() {
+      SystraceSection s("AndroidTextInputComponentDescriptor::getThemeData");
+      return getThemeData(
+          fabricUIManager, surfaceId, defaultTextInputPaddingArray);
+    }();
+
+    if (themeDataRequested) {
+      jfloat *defaultTextInputPadding =
+          env->GetFloatArrayElements(defaultTextInputPaddingArray, 0);
+      theme[ABI45_0_0YGEdgeStart] = (ABI45_0_0YGValue){defaultTextInputPadding[0], ABI45_0_0YGUnitPoint};
+      theme[ABI45_0_0YGEdgeEnd] = (ABI45_0_0YGValue){defaultTextInputPadding[1], ABI45_0_0YGUnitPoint};
+      theme[ABI45_0_0YGEdgeTop] = (ABI45_0_0YGValue){defaultTextInputPadding[2], ABI45_0_0YGUnitPoint};
+      theme[ABI45_0_0YGEdgeBottom] = (ABI45_0_0YGValue){defaultTextInputPadding[3], ABI45_0_0YGUnitPoint};
+      env->ReleaseFloatArrayElements(
+          defaultTextInputPaddingArray, defaultTextInputPadding, JNI_ABORT);
+
+      // If another thread resolved the padding in the meantime, its value
+      // (which is the same) is kept.
+      std::unique_lock<std::shared_mutex> lock(themePaddingMutex_);
+      surfaceIdToThemePaddingMap_.emplace(surfaceId, theme);
+    }
+    env->DeleteLocalRef(defaultTextInputPaddingArray);
+
+    return theme;
+  }
+
   // TODO T68526882: Unify with Binding::UIManagerJavaDescriptor
   constexpr static auto UIManagerJavaDescriptor =
       "com/facebook/ABI45_0_0React/fabric/FabricUIManager";
 
   SharedTextLayoutManager textLayoutManager_;
+  AndroidTextInputMeasurementCache::Shared measurementCache_;
+  bool paragraphChunkedMeasurementEnabled_{false};
+  bool telemetryEnabled_{false};
+  /*
+   * Theme padding per surface, written once per surface and read by every
+   * text input created on it.
+   * The component descriptor is not notified when a surface stops, so
+   * entries are kept for the lifetime of the descriptor; they are tiny and
+   * surface ids are not reused.
+   */
+  mutable std::shared_mutex themePaddingMutex_;
   mutable butter::map<int, ABI45_0_0YGStyle::Edges> surfaceIdToThemePaddingMap_;
 };
 
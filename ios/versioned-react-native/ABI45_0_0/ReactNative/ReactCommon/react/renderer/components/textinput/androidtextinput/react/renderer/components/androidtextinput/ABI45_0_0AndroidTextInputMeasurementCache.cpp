@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ABI45_0_0AndroidTextInputMeasurementCache.h"
+
+#include <folly/Hash.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/components/text/BaseTextShadowNode.h>
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+/*
+ * Size with which the fragment is laid out if it is an attachment.
+ */
+static Size attachmentSize(AttributedString::Fragment const &fragment) {
+  return fragment.isAttachment()
+      ? fragment.parentShadowView.layoutMetrics.frame.size
+      : Size{};
+}
+
+/*
+ * Compares the parts of the string which are hashed by `getLayoutHash` with
+ * layout fragments.
+ */
+static bool layoutEquals(
+    AttributedString const &attributedString,
+    std::vector<AndroidTextInputLayoutFragment> const &layoutFragments) {
+  auto const &fragments = attributedString.getFragments();
+  if (fragments.size() != layoutFragments.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < fragments.size(); i++) {
+    if (fragments[i].string != layoutFragments[i].string ||
+        fragments[i].textAttributes != layoutFragments[i].textAttributes ||
+        attachmentSize(fragments[i]) != layoutFragments[i].attachmentSize) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::vector<AndroidTextInputLayoutFragment> getLayoutFragments(
+    AttributedString const &attributedString) {
+  auto layoutFragments = std::vector<AndroidTextInputLayoutFragment>{};
+  layoutFragments.reserve(attributedString.getFragments().size());
+  for (auto const &fragment : attributedString.getFragments()) {
+    layoutFragments.push_back(
+        {fragment.string, fragment.textAttributes, attachmentSize(fragment)});
+  }
+  return layoutFragments;
+}
+
+/*
+ * Calls `function` with every non-empty piece of `paragraph`: a fragment and
+ * the part of its string which belongs to the paragraph; or with the
+ * placeholder of an empty paragraph.
+ */
+template <typename Function>
+static void forEachPiece(
+    AndroidTextInputParagraph const &paragraph,
+    Function const &function) {
+  auto const &fragments = paragraph.attributedString->getFragments();
+  auto isEmpty = true;
+  for (auto i = paragraph.firstFragment; i <= paragraph.lastFragment; i++) {
+    auto string = std::string_view{fragments[i].string};
+    auto begin = i == paragraph.firstFragment ? paragraph.begin : 0;
+    auto end = i == paragraph.lastFragment ? paragraph.end : string.size();
+    if (begin < end) {
+      isEmpty = false;
+      function(fragments[i], string.substr(begin, end - begin));
+    }
+  }
+
+  if (isEmpty) {
+    auto placeholder = BaseTextShadowNode::getEmptyPlaceholder();
+    function(fragments[paragraph.lastFragment], std::string_view{placeholder});
+  }
+}
+
+/*
+ * Same as `getLayoutHash`, but for a paragraph. Only used by the paragraph
+ * caches, so it does not need to match `getLayoutHash` of the copy.
+ */
+static size_t getParagraphLayoutHash(
+    AndroidTextInputParagraph const &paragraph) {
+  auto hash = size_t{0};
+  forEachPiece(
+      paragraph,
+      [&](AttributedString::Fragment const &fragment, std::string_view piece) {
+        hash = folly::hash::hash_combine(
+            hash, std::hash<std::string_view>{}(piece), fragment.textAttributes);
+        if (fragment.isAttachment()) {
+          auto size = attachmentSize(fragment);
+          hash = folly::hash::hash_combine(hash, size.width, size.height);
+        }
+      });
+  return hash;
+}
+
+/*
+ * Same as `layoutEquals` of a string, comparing `paragraph` in place with
+ * the layout fragments of a copy of a paragraph.
+ */
+static bool layoutEquals(
+    AndroidTextInputParagraph const &paragraph,
+    std::vector<AndroidTextInputLayoutFragment> const &layoutFragments) {
+  auto index = size_t{0};
+  auto equals = true;
+  forEachPiece(
+      paragraph,
+      [&](AttributedString::Fragment const &fragment, std::string_view piece) {
+        if (!equals || index >= layoutFragments.size()) {
+          equals = false;
+          return;
+        }
+        auto const &other = layoutFragments[index++];
+        equals = piece == other.string &&
+            fragment.textAttributes == other.textAttributes &&
+            attachmentSize(fragment) == other.attachmentSize;
+      });
+  return equals && index == layoutFragments.size();
+}
+
+bool AndroidTextInputLayoutFragment::operator==(
+    AndroidTextInputLayoutFragment const &rhs) const {
+  return string == rhs.string && textAttributes == rhs.textAttributes &&
+      attachmentSize == rhs.attachmentSize;
+}
+
+bool AndroidTextInputMeasurementCacheKey::operator==(
+    AndroidTextInputMeasurementCacheKey const &rhs) const {
+  if (hash != rhs.hash || !(layoutConstraints == rhs.layoutConstraints) ||
+      !(paragraphAttributes == rhs.paragraphAttributes)) {
+    return false;
+  }
+  // At most one of two compared keys is a lookup key.
+  if (attributedString != nullptr) {
+    return layoutEquals(*attributedString, rhs.fragments);
+  }
+  if (rhs.attributedString != nullptr) {
+    return layoutEquals(*rhs.attributedString, fragments);
+  }
+  return fragments == rhs.fragments;
+}
+
+size_t AndroidTextInputMeasurementCache::getLayoutHash(
+    AttributedString const &attributedString) {
+  auto hash = size_t{0};
+  for (auto const &fragment : attributedString.getFragments()) {
+    hash = folly::hash::hash_combine(
+        hash, fragment.string, fragment.textAttributes);
+    if (fragment.isAttachment()) {
+      auto size = attachmentSize(fragment);
+      hash = folly::hash::hash_combine(hash, size.width, size.height);
+    }
+  }
+  return hash;
+}
+
+TextMeasurement AndroidTextInputMeasurementCache::measure(
+    AttributedString const &attributedString,
+    size_t layoutHash,
+    ParagraphAttributes const &paragraphAttributes,
+    LayoutConstraints const &layoutConstraints,
+    std::function<TextMeasurement()> const &measure) const {
+  requestCount_.fetch_add(1, std::memory_order_relaxed);
+  return store_.get(
+      attributedString,
+      layoutHash,
+      paragraphAttributes,
+      layoutConstraints,
+      measure,
+      missCount_);
+}
+
+TextMeasurement AndroidTextInputMeasurementCache::measure(
+    AttributedString const &attributedString,
+    ParagraphAttributes const &paragraphAttributes,
+    LayoutConstraints const &layoutConstraints,
+    std::function<TextMeasurement()> const &measure) const {
+  return this->measure(
+      attributedString,
+      getLayoutHash(attributedString),
+      paragraphAttributes,
+      layoutConstraints,
+      measure);
+}
+
+std::shared_ptr<AndroidTextInputMeasurementCache::ParagraphCache>
+AndroidTextInputMeasurementCache::getParagraphCache(
+    SurfaceId surfaceId) const {
+  std::lock_guard<std::mutex> lock(paragraphCachesMutex_);
+  auto &weakParagraphCache = paragraphCaches_[surfaceId];
+  auto paragraphCache = weakParagraphCache.lock();
+  if (paragraphCache) {
+    return paragraphCache;
+  }
+
+  // Caches are only requested for new shadow node families, so dropping
+  // caches of stopped surfaces here keeps the map small at little cost.
+  for (auto iterator = paragraphCaches_.begin();
+       iterator != paragraphCaches_.end();) {
+    if (iterator->first != surfaceId && iterator->second.expired()) {
+      iterator = paragraphCaches_.erase(iterator);
+    } else {
+      iterator++;
+    }
+  }
+
+  paragraphCache = std::make_shared<ParagraphCache>();
+  weakParagraphCache = paragraphCache;
+  return paragraphCache;
+}
+
+TextMeasurement AndroidTextInputMeasurementCache::measureParagraph(
+    ParagraphCache &paragraphCache,
+    AndroidTextInputParagraph const &paragraph,
+    ParagraphAttributes const &paragraphAttributes,
+    LayoutConstraints const &layoutConstraints,
+    std::function<TextMeasurement(AttributedString const &paragraph)> const
+        &measure) const {
+  requestCount_.fetch_add(1, std::memory_order_relaxed);
+
+  auto hash = folly::hash::hash_combine(
+      getParagraphLayoutHash(paragraph), paragraphAttributes, layoutConstraints);
+  {
+    std::lock_guard<std::mutex> lock(paragraphCache.mutex_);
+    auto iterator = paragraphCache.map_.find(hash);
+    if (iterator != paragraphCache.map_.end()) {
+      auto const &entry = iterator->second;
+      if (entry.layoutConstraints == layoutConstraints &&
+          entry.paragraphAttributes == paragraphAttributes &&
+          layoutEquals(paragraph, entry.fragments)) {
+        return entry.measurement;
+      }
+    }
+  }
+
+  missCount_.fetch_add(1, std::memory_order_relaxed);
+  auto attributedString = paragraph.toAttributedString();
+  auto measurement = measure(attributedString);
+  auto entry = ParagraphCache::Entry{
+      getLayoutFragments(attributedString),
+      paragraphAttributes,
+      layoutConstraints,
+      measurement};
+
+  std::lock_guard<std::mutex> lock(paragraphCache.mutex_);
+  paragraphCache.map_.set(hash, std::move(entry));
+  return measurement;
+}
+
+size_t AndroidTextInputMeasurementCache::getHitCount() const {
+  return requestCount_.load(std::memory_order_relaxed) -
+      missCount_.load(std::memory_order_relaxed);
+}
+
+size_t AndroidTextInputMeasurementCache::getMissCount() const {
+  return missCount_.load(std::memory_order_relaxed);
+}
+
+#pragma mark - AndroidTextInputParagraph
+
+std::vector<AndroidTextInputParagraph> AndroidTextInputParagraph::split(
+    AttributedString const &attributedString) {
+  auto paragraphs = std::vector<AndroidTextInputParagraph>{};
+  auto const &fragments = attributedString.getFragments();
+  if (fragments.empty()) {
+    return paragraphs;
+  }
+
+  auto paragraph = AndroidTextInputParagraph{&attributedString, 0, 0, 0, 0};
+  for (size_t i = 0; i < fragments.size(); i++) {
+    auto const &string = fragments[i].string;
+    for (auto end = string.find('\n'); end != std::string::npos;
+         end = string.find('\n', end + 1)) {
+      paragraph.lastFragment = i;
+      paragraph.end = end;
+      paragraphs.push_back(paragraph);
+      paragraph.firstFragment = i;
+      paragraph.begin = end + 1;
+    }
+  }
+
+  paragraph.lastFragment = fragments.size() - 1;
+  paragraph.end = fragments.back().string.size();
+  paragraphs.push_back(paragraph);
+  return paragraphs;
+}
+
+AttributedString AndroidTextInputParagraph::toAttributedString() const {
+  auto attributedString = AttributedString{};
+  forEachPiece(
+      *this,
+      [&](AttributedString::Fragment const &source, std::string_view piece) {
+        auto fragment = AttributedString::Fragment{};
+        fragment.string = std::string{piece};
+        fragment.textAttributes = source.textAttributes;
+        fragment.parentShadowView = source.parentShadowView;
+        attributedString.appendFragment(std::move(fragment));
+      });
+  return attributedString;
+}
+
+#pragma mark - ParagraphCache
+
+AndroidTextInputMeasurementCache::ParagraphCache::ParagraphCache()
+    : map_(kParagraphCacheSize) {}
+
+void AndroidTextInputMeasurementCache::ParagraphCache::reserve(size_t count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto size = std::min(count, kMaxParagraphCacheSize);
+  if (size > map_.getMaxSize()) {
+    map_.setMaxSize(size);
+  }
+}
+
+#pragma mark - Store
+
+AndroidTextInputMeasurementCache::Store::Store(size_t capacity)
+    : map_(capacity) {}
+
+TextMeasurement AndroidTextInputMeasurementCache::Store::get(
+    AttributedString const &attributedString,
+    size_t layoutHash,
+    ParagraphAttributes const &paragraphAttributes,
+    LayoutConstraints const &layoutConstraints,
+    std::function<TextMeasurement()> const &measure,
+    std::atomic<size_t> &missCount) {
+  // The lookup key points to the caller's string without copying it.
+  auto key = AndroidTextInputMeasurementCacheKey{
+      layoutHash,
+      &attributedString,
+      {},
+      paragraphAttributes,
+      layoutConstraints};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iterator = map_.find(key);
+    if (iterator != map_.end()) {
+      return iterator->second;
+    }
+  }
+
+  missCount.fetch_add(1, std::memory_order_relaxed);
+  auto measurement = measure();
+
+  // Only keys stored in the cache own (the layout fragments of) the string.
+  key.attributedString = nullptr;
+  key.fragments = getLayoutFragments(attributedString);
+  std::lock_guard<std::mutex> lock(mutex_);
+  map_.set(std::move(key), measurement);
+  return measurement;
+}
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/container/EvictingCacheMap.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/AttributedString.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/ParagraphAttributes.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/TextAttributes.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/core/LayoutConstraints.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/core/ReactPrimitives.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/graphics/Geometry.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/textlayoutmanager/TextLayoutManager.h>
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+/*
+ * The part of a fragment which affects text layout: its string, its text
+ * attributes and, for attachments, the size of its parent shadow view (which
+ * the attachment is laid out with). The cache stores those instead of
+ * fragments, whose parent shadow views retain their props and state (and,
+ * through them, possibly whole documents).
+ */
+struct AndroidTextInputLayoutFragment final {
+  std::string string;
+  TextAttributes textAttributes;
+  Size attachmentSize;
+
+  bool operator==(AndroidTextInputLayoutFragment const &rhs) const;
+};
+
+/*
+ * Key of `AndroidTextInputMeasurementCache`.
+ * Keys stored in the cache own the layout fragments of the string; keys built
+ * for lookups only point to the caller's string, so a cache hit does not copy
+ * it. `hash` is computed by the caller (see
+ * `AndroidTextInputMeasurementCache::getLayoutHash`).
+ */
+class AndroidTextInputMeasurementCacheKey final {
+ public:
+  size_t hash;
+  // Set in lookup keys only.
+  AttributedString const *attributedString;
+  // Set in stored keys only.
+  std::vector<AndroidTextInputLayoutFragment> fragments;
+  ParagraphAttributes paragraphAttributes;
+  LayoutConstraints layoutConstraints;
+
+  bool operator==(AndroidTextInputMeasurementCacheKey const &rhs) const;
+};
+
+struct AndroidTextInputMeasurementCacheKeyHash final {
+  size_t operator()(AndroidTextInputMeasurementCacheKey const &key) const {
+    return key.hash;
+  }
+};
+
+/*
+ * A paragraph (a run of text between line breaks, which are not part of it)
+ * of an attributed string, referred to by indices instead of being copied:
+ * bytes from `begin` of fragment `firstFragment` to `end` of fragment
+ * `lastFragment`. An empty paragraph is laid out as a placeholder character
+ * with the attributes of `lastFragment`, so it takes the height of a line.
+ * The attributed string must outlive the paragraph.
+ */
+struct AndroidTextInputParagraph final {
+  AttributedString const *attributedString;
+  size_t firstFragment;
+  size_t begin;
+  size_t lastFragment;
+  size_t end;
+
+  /*
+   * Returns the paragraphs of `attributedString`, in order; none if it has no
+   * fragments.
+   */
+  static std::vector<AndroidTextInputParagraph> split(
+      AttributedString const &attributedString);
+
+  /*
+   * Returns a copy of the paragraph as a self-contained attributed string.
+   */
+  AttributedString toAttributedString() const;
+};
+
+/*
+ * Bounded (LRU) cache of text measurements of <TextInput> content.
+ * Measuring goes through JNI into Java text layout, so re-measuring inputs
+ * whose content, paragraph attributes and constraints did not change (e.g.
+ * when an unrelated sibling changes) is answered from here instead.
+ * Only attributes which affect text layout are part of the key: strings and
+ * text attributes of fragments, and the sizes of attachments (which are laid
+ * out with the frames of their shadow views). Frames of other parent shadow
+ * views are ignored.
+ * `measure` runs without holding the lock of the cache.
+ * The class is thread-safe.
+ */
+class AndroidTextInputMeasurementCache final {
+ public:
+  using Shared = std::shared_ptr<AndroidTextInputMeasurementCache const>;
+
+  /*
+   * Returns the hash of the parts of `attributedString` which are part of the
+   * key. Callers measuring the same string repeatedly (e.g. with different
+   * constraints during a single layout pass) should compute it once.
+   */
+  static size_t getLayoutHash(AttributedString const &attributedString);
+
+  /*
+   * Returns the cached measurement for given arguments, calling `measure`
+   * to compute (and cache) it if there is none.
+   * `layoutHash` must be `getLayoutHash(attributedString)`.
+   */
+  TextMeasurement measure(
+      AttributedString const &attributedString,
+      size_t layoutHash,
+      ParagraphAttributes const &paragraphAttributes,
+      LayoutConstraints const &layoutConstraints,
+      std::function<TextMeasurement()> const &measure) const;
+  TextMeasurement measure(
+      AttributedString const &attributedString,
+      ParagraphAttributes const &paragraphAttributes,
+      LayoutConstraints const &layoutConstraints,
+      std::function<TextMeasurement()> const &measure) const;
+
+  /*
+   * Cache of paragraph measurements of one surface (see `measureParagraph`).
+   */
+  class ParagraphCache;
+
+  /*
+   * Returns the paragraph cache of the surface, creating it if needed.
+   * Paragraph caches are kept as long as they are referenced (by the shadow
+   * nodes of the surface): the component descriptor is not notified when a
+   * surface stops, so its cache is dropped with its last node.
+   */
+  std::shared_ptr<ParagraphCache> getParagraphCache(SurfaceId surfaceId) const;
+
+  /*
+   * Same as `measure`, but for a single paragraph of a large multiline input
+   * (see `AndroidTextInputShadowNode::measureContent`), cached in the
+   * `paragraphCache` of its surface. Paragraphs are cached separately from
+   * whole inputs and there may be thousands of them, so other surfaces (and
+   * whole inputs) do not evict them. Cache hits compare the paragraph in
+   * place; `measure` gets a copy of it on misses only, and only its layout
+   * fragments are kept.
+   */
+  TextMeasurement measureParagraph(
+      ParagraphCache &paragraphCache,
+      AndroidTextInputParagraph const &paragraph,
+      ParagraphAttributes const &paragraphAttributes,
+      LayoutConstraints const &layoutConstraints,
+      std::function<TextMeasurement(AttributedString const &paragraph)> const
+          &measure) const;
+
+  /*
+   * Returns the number of `measure` calls that were (not) answered from the
+   * cache so far.
+   */
+  size_t getHitCount() const;
+  size_t getMissCount() const;
+
+ private:
+  /*
+   * Maximum number of measurements kept in the cache.
+   */
+  static constexpr size_t kCacheSize = 256;
+
+  /*
+   * Thread-safe LRU map of measurements.
+   */
+  class Store final {
+   public:
+    explicit Store(size_t capacity);
+
+    TextMeasurement get(
+        AttributedString const &attributedString,
+        size_t layoutHash,
+        ParagraphAttributes const &paragraphAttributes,
+        LayoutConstraints const &layoutConstraints,
+        std::function<TextMeasurement()> const &measure,
+        std::atomic<size_t> &missCount);
+
+   private:
+    std::mutex mutex_;
+    folly::EvictingCacheMap<
+        AndroidTextInputMeasurementCacheKey,
+        TextMeasurement,
+        AndroidTextInputMeasurementCacheKeyHash>
+        map_;
+  };
+
+  mutable Store store_{kCacheSize};
+  mutable std::atomic<size_t> requestCount_{0};
+  mutable std::atomic<size_t> missCount_{0};
+
+  mutable std::mutex paragraphCachesMutex_;
+  mutable std::unordered_map<SurfaceId, std::weak_ptr<ParagraphCache>>
+      paragraphCaches_;
+};
+
+class AndroidTextInputMeasurementCache::ParagraphCache final {
+ public:
+  ParagraphCache();
+
+  /*
+   * Makes room for at least `count` measurements (up to
+   * `kMaxParagraphCacheSize`), so measuring all paragraphs of an input does
+   * not evict the ones measured at the beginning of the same pass.
+   */
+  void reserve(size_t count);
+
+ private:
+  friend class AndroidTextInputMeasurementCache;
+
+  /*
+   * Initial and maximum number of paragraph measurements kept per surface.
+   */
+  static constexpr size_t kParagraphCacheSize = 1024;
+  static constexpr size_t kMaxParagraphCacheSize = 16384;
+
+  struct Entry {
+    std::vector<AndroidTextInputLayoutFragment> fragments;
+    ParagraphAttributes paragraphAttributes;
+    LayoutConstraints layoutConstraints;
+    TextMeasurement measurement;
+  };
+
+  std::mutex mutex_;
+
+  /*
+   * Entries by the hash of the paragraph and its layout arguments. Colliding
+   * entries replace each other.
+   */
+  folly::EvictingCacheMap<size_t, Entry> map_;
+};
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
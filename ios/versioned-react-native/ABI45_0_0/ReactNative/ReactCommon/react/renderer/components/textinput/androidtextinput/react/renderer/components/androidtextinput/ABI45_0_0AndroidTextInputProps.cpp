@@ -10,6 +10,8 @@
 #include <ABI45_0_0React/ABI45_0_0renderer/core/propsConversions.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/graphics/conversions.h>
 
+#include <cmath>
+
 namespace ABI45_0_0facebook {
 namespace ABI45_0_0React {
 
@@ -36,10 +38,82 @@ static bool hasValue(
   return false;
 }
 
+namespace {
+
+struct PaddingProp {
+  const char *name;
+  const bool AndroidTextInputProps::*field;
+};
+
+} // namespace
+
+// Names (after the "padding" prefix) of padding props and the `hasPadding*`
+// fields they are parsed into; defines the order of `PaddingPresence`.
+static constexpr std::array<PaddingProp, 9> paddingProps = {{
+    {"", &AndroidTextInputProps::hasPadding},
+    {"Horizontal", &AndroidTextInputProps::hasPaddingHorizontal},
+    {"Vertical", &AndroidTextInputProps::hasPaddingVertical},
+    {"Left", &AndroidTextInputProps::hasPaddingLeft},
+    {"Top", &AndroidTextInputProps::hasPaddingTop},
+    {"Right", &AndroidTextInputProps::hasPaddingRight},
+    {"Bottom", &AndroidTextInputProps::hasPaddingBottom},
+    {"Start", &AndroidTextInputProps::hasPaddingStart},
+    {"End", &AndroidTextInputProps::hasPaddingEnd},
+}};
+
+/*
+ * Returns the value parsed into `field` from a result of
+ * `parsePaddingPresence`, which is ordered as `paddingProps`.
+ */
+template <const bool AndroidTextInputProps::*field>
+static bool paddingPresenceOf(
+    const std::array<bool, paddingProps.size()> &paddingPresence) {
+  constexpr auto index = [] {
+    size_t index = 0;
+    while (index < paddingProps.size() && paddingProps[index].field != field) {
+      index++;
+    }
+    return index;
+  }();
+  static_assert(index < paddingProps.size(), "Not a padding prop.");
+  return paddingPresence[index];
+}
+
+AndroidTextInputProps::PaddingPresence
+AndroidTextInputProps::parsePaddingPresence(
+    const AndroidTextInputProps &sourceProps,
+    const RawProps &rawProps) {
+  static_assert(
+      paddingProps.size() == std::tuple_size<PaddingPresence>::value,
+      "Every padding prop needs a `PaddingPresence` entry.");
+
+  auto paddingPresence = PaddingPresence{};
+  for (size_t i = 0; i < paddingProps.size(); i++) {
+    paddingPresence[i] = hasValue(
+        rawProps,
+        sourceProps.*(paddingProps[i].field),
+        paddingProps[i].name,
+        "padding",
+        "");
+  }
+  return paddingPresence;
+}
+
 AndroidTextInputProps::AndroidTextInputProps(
     const PropsParserContext &context,
     const AndroidTextInputProps &sourceProps,
     const RawProps &rawProps)
+    : AndroidTextInputProps(
+          context,
+          sourceProps,
+          rawProps,
+          parsePaddingPresence(sourceProps, rawProps)) {}
+
+AndroidTextInputProps::AndroidTextInputProps(
+    const PropsParserContext &context,
+    const AndroidTextInputProps &sourceProps,
+    const RawProps &rawProps,
+    const PaddingPresence &paddingPresence)
     : ViewProps(context, sourceProps, rawProps),
       BaseTextProps(context, sourceProps, rawProps),
       autoComplete(convertRawProp(
@@ -215,111 +289,142 @@ AndroidTextInputProps::AndroidTextInputProps(
           convertRawProp(context, rawProps, sourceProps.paragraphAttributes, {})),
       // See AndroidTextInputComponentDescriptor for usage
       // TODO T63008435: can these, and this feature, be removed entirely?
-      hasPadding(hasValue(rawProps, sourceProps.hasPadding, "", "padding", "")),
-      hasPaddingHorizontal(hasValue(
-          rawProps,
-          sourceProps.hasPaddingHorizontal,
-          "Horizontal",
-          "padding",
-          "")),
-      hasPaddingVertical(hasValue(
-          rawProps,
-          sourceProps.hasPaddingVertical,
-          "Vertical",
-          "padding",
-          "")),
-      hasPaddingLeft(hasValue(
-          rawProps,
-          sourceProps.hasPaddingLeft,
-          "Left",
-          "padding",
-          "")),
-      hasPaddingTop(
-          hasValue(rawProps, sourceProps.hasPaddingTop, "Top", "padding", "")),
-      hasPaddingRight(hasValue(
-          rawProps,
-          sourceProps.hasPaddingRight,
-          "Right",
-          "padding",
-          "")),
-      hasPaddingBottom(hasValue(
-          rawProps,
-          sourceProps.hasPaddingBottom,
-          "Bottom",
-          "padding",
-          "")),
-      hasPaddingStart(hasValue(
-          rawProps,
-          sourceProps.hasPaddingStart,
-          "Start",
-          "padding",
-          "")),
-      hasPaddingEnd(
-          hasValue(rawProps, sourceProps.hasPaddingEnd, "End", "padding", "")) {
+      hasPadding(paddingPresenceOf<&AndroidTextInputProps::hasPadding>(
+          paddingPresence)),
+      hasPaddingHorizontal(
+          paddingPresenceOf<&AndroidTextInputProps::hasPaddingHorizontal>(
+              paddingPresence)),
+      hasPaddingVertical(
+          paddingPresenceOf<&AndroidTextInputProps::hasPaddingVertical>(
+              paddingPresence)),
+      hasPaddingLeft(paddingPresenceOf<&AndroidTextInputProps::hasPaddingLeft>(
+          paddingPresence)),
+      hasPaddingTop(paddingPresenceOf<&AndroidTextInputProps::hasPaddingTop>(
+          paddingPresence)),
+      hasPaddingRight(
+          paddingPresenceOf<&AndroidTextInputProps::hasPaddingRight>(
+              paddingPresence)),
+      hasPaddingBottom(
+          paddingPresenceOf<&AndroidTextInputProps::hasPaddingBottom>(
+              paddingPresence)),
+      hasPaddingStart(
+          paddingPresenceOf<&AndroidTextInputProps::hasPaddingStart>(
+              paddingPresence)),
+      hasPaddingEnd(paddingPresenceOf<&AndroidTextInputProps::hasPaddingEnd>(
+          paddingPresence)) {}
+
+static folly::dynamic propValueToDynamic(SharedColor const &value) {
+  return toDynamic(value);
+}
+
+static folly::dynamic propValueToDynamic(
+    AndroidTextInputSelectionStruct const &value) {
+  return toDynamic(value);
+}
+
+static folly::dynamic propValueToDynamic(
+    AndroidTextInputTextShadowOffsetStruct const &value) {
+  return toDynamic(value);
+}
+
+template <typename T>
+static folly::dynamic propValueToDynamic(T const &value) {
+  return value;
+}
+
+static bool propValueEquals(Float const &lhs, Float const &rhs) {
+  return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+
+static bool propValueEquals(
+    AndroidTextInputTextShadowOffsetStruct const &lhs,
+    AndroidTextInputTextShadowOffsetStruct const &rhs) {
+  auto equals = [](double lhs, double rhs) {
+    return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+  };
+  return equals(lhs.width, rhs.width) && equals(lhs.height, rhs.height);
+}
+
+template <typename T>
+static bool propValueEquals(T const &lhs, T const &rhs) {
+  return lhs == rhs;
 }
 
 // TODO T53300085: support this in codegen; this was hand-written
 folly::dynamic AndroidTextInputProps::getDynamic() const {
+  return getDiffProps(nullptr);
+}
+
+folly::dynamic AndroidTextInputProps::getDiffProps(
+    AndroidTextInputProps const *prevProps) const {
   folly::dynamic props = folly::dynamic::object();
-  props["autoComplete"] = autoComplete;
-  props["returnKeyLabel"] = returnKeyLabel;
-  props["numberOfLines"] = numberOfLines;
-  props["disableFullscreenUI"] = disableFullscreenUI;
-  props["textBreakStrategy"] = textBreakStrategy;
-  props["underlineColorAndroid"] = toDynamic(underlineColorAndroid);
-  props["inlineImageLeft"] = inlineImageLeft;
-  props["inlineImagePadding"] = inlineImagePadding;
-  props["importantForAutofill"] = importantForAutofill;
-  props["showSoftInputOnFocus"] = showSoftInputOnFocus;
-  props["autoCapitalize"] = autoCapitalize;
-  props["autoCorrect"] = autoCorrect;
-  props["autoFocus"] = autoFocus;
-  props["allowFontScaling"] = allowFontScaling;
-  props["maxFontSizeMultiplier"] = maxFontSizeMultiplier;
-  props["editable"] = editable;
-  props["keyboardType"] = keyboardType;
-  props["returnKeyType"] = returnKeyType;
-  props["maxLength"] = maxLength;
-  props["multiline"] = multiline;
-  props["placeholder"] = placeholder;
-  props["placeholderTextColor"] = toDynamic(placeholderTextColor);
-  props["secureTextEntry"] = secureTextEntry;
-  props["selectionColor"] = toDynamic(selectionColor);
-  props["selection"] = toDynamic(selection);
-  props["value"] = value;
-  props["defaultValue"] = defaultValue;
-  props["selectTextOnFocus"] = selectTextOnFocus;
-  props["blurOnSubmit"] = blurOnSubmit;
-  props["caretHidden"] = caretHidden;
-  props["contextMenuHidden"] = contextMenuHidden;
-  props["textShadowColor"] = toDynamic(textShadowColor);
-  props["textShadowRadius"] = textShadowRadius;
-  props["textDecorationLine"] = textDecorationLine;
-  props["fontStyle"] = fontStyle;
-  props["textShadowOffset"] = toDynamic(textShadowOffset);
-  props["lineHeight"] = lineHeight;
-  props["textTransform"] = textTransform;
-  props["color"] = toDynamic(color);
-  props["letterSpacing"] = letterSpacing;
-  props["fontSize"] = fontSize;
-  props["textAlign"] = textAlign;
-  props["includeFontPadding"] = includeFontPadding;
-  props["fontWeight"] = fontWeight;
-  props["fontFamily"] = fontFamily;
-  props["textAlignVertical"] = textAlignVertical;
-  props["cursorColor"] = toDynamic(cursorColor);
-  props["mostRecentEventCount"] = mostRecentEventCount;
-  props["text"] = text;
-
-  props["hasPadding"] = hasPadding;
-  props["hasPaddingHorizontal"] = hasPaddingHorizontal;
-  props["hasPaddingVertical"] = hasPaddingVertical;
-  props["hasPaddingStart"] = hasPaddingStart;
-  props["hasPaddingEnd"] = hasPaddingEnd;
-  props["hasPaddingLeft"] = hasPaddingLeft;
-  props["hasPaddingRight"] = hasPaddingRight;
-  props["hasPaddingTop"] = hasPaddingTop;
-  props["hasPaddingBottom"] = hasPaddingBottom;
+
+  auto diffProp = [&](char const *name, auto member) {
+    if (prevProps == nullptr ||
+        !propValueEquals(prevProps->*member, this->*member)) {
+      props[name] = propValueToDynamic(this->*member);
+    }
+  };
+
+  diffProp("autoComplete", &AndroidTextInputProps::autoComplete);
+  diffProp("returnKeyLabel", &AndroidTextInputProps::returnKeyLabel);
+  diffProp("numberOfLines", &AndroidTextInputProps::numberOfLines);
+  diffProp("disableFullscreenUI", &AndroidTextInputProps::disableFullscreenUI);
+  diffProp("textBreakStrategy", &AndroidTextInputProps::textBreakStrategy);
+  diffProp("underlineColorAndroid", &AndroidTextInputProps::underlineColorAndroid);
+  diffProp("inlineImageLeft", &AndroidTextInputProps::inlineImageLeft);
+  diffProp("inlineImagePadding", &AndroidTextInputProps::inlineImagePadding);
+  diffProp("importantForAutofill", &AndroidTextInputProps::importantForAutofill);
+  diffProp("showSoftInputOnFocus", &AndroidTextInputProps::showSoftInputOnFocus);
+  diffProp("autoCapitalize", &AndroidTextInputProps::autoCapitalize);
+  diffProp("autoCorrect", &AndroidTextInputProps::autoCorrect);
+  diffProp("autoFocus", &AndroidTextInputProps::autoFocus);
+  diffProp("allowFontScaling", &AndroidTextInputProps::allowFontScaling);
+  diffProp("maxFontSizeMultiplier", &AndroidTextInputProps::maxFontSizeMultiplier);
+  diffProp("editable", &AndroidTextInputProps::editable);
+  diffProp("keyboardType", &AndroidTextInputProps::keyboardType);
+  diffProp("returnKeyType", &AndroidTextInputProps::returnKeyType);
+  diffProp("maxLength", &AndroidTextInputProps::maxLength);
+  diffProp("multiline", &AndroidTextInputProps::multiline);
+  diffProp("placeholder", &AndroidTextInputProps::placeholder);
+  diffProp("placeholderTextColor", &AndroidTextInputProps::placeholderTextColor);
+  diffProp("secureTextEntry", &AndroidTextInputProps::secureTextEntry);
+  diffProp("selectionColor", &AndroidTextInputProps::selectionColor);
+  diffProp("selection", &AndroidTextInputProps::selection);
+  diffProp("value", &AndroidTextInputProps::value);
+  diffProp("defaultValue", &AndroidTextInputProps::defaultValue);
+  diffProp("selectTextOnFocus", &AndroidTextInputProps::selectTextOnFocus);
+  diffProp("blurOnSubmit", &AndroidTextInputProps::blurOnSubmit);
+  diffProp("caretHidden", &AndroidTextInputProps::caretHidden);
+  diffProp("contextMenuHidden", &AndroidTextInputProps::contextMenuHidden);
+  diffProp("textShadowColor", &AndroidTextInputProps::textShadowColor);
+  diffProp("textShadowRadius", &AndroidTextInputProps::textShadowRadius);
+  diffProp("textDecorationLine", &AndroidTextInputProps::textDecorationLine);
+  diffProp("fontStyle", &AndroidTextInputProps::fontStyle);
+  diffProp("textShadowOffset", &AndroidTextInputProps::textShadowOffset);
+  diffProp("lineHeight", &AndroidTextInputProps::lineHeight);
+  diffProp("textTransform", &AndroidTextInputProps::textTransform);
+  diffProp("color", &AndroidTextInputProps::color);
+  diffProp("letterSpacing", &AndroidTextInputProps::letterSpacing);
+  diffProp("fontSize", &AndroidTextInputProps::fontSize);
+  diffProp("textAlign", &AndroidTextInputProps::textAlign);
+  diffProp("includeFontPadding", &AndroidTextInputProps::includeFontPadding);
+  diffProp("fontWeight", &AndroidTextInputProps::fontWeight);
+  diffProp("fontFamily", &AndroidTextInputProps::fontFamily);
+  diffProp("textAlignVertical", &AndroidTextInputProps::textAlignVertical);
+  diffProp("cursorColor", &AndroidTextInputProps::cursorColor);
+  diffProp("mostRecentEventCount", &AndroidTextInputProps::mostRecentEventCount);
+  diffProp("text", &AndroidTextInputProps::text);
+
+  diffProp("hasPadding", &AndroidTextInputProps::hasPadding);
+  diffProp("hasPaddingHorizontal", &AndroidTextInputProps::hasPaddingHorizontal);
+  diffProp("hasPaddingVertical", &AndroidTextInputProps::hasPaddingVertical);
+  diffProp("hasPaddingStart", &AndroidTextInputProps::hasPaddingStart);
+  diffProp("hasPaddingEnd", &AndroidTextInputProps::hasPaddingEnd);
+  diffProp("hasPaddingLeft", &AndroidTextInputProps::hasPaddingLeft);
+  diffProp("hasPaddingRight", &AndroidTextInputProps::hasPaddingRight);
+  diffProp("hasPaddingTop", &AndroidTextInputProps::hasPaddingTop);
+  diffProp("hasPaddingBottom", &AndroidTextInputProps::hasPaddingBottom);
 
   return props;
 }
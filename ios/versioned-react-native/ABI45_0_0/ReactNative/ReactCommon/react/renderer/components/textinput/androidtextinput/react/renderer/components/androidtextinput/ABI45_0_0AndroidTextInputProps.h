@@ -22,6 +22,7 @@
 #include <ABI45_0_0React/ABI45_0_0renderer/core/propsConversions.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/graphics/Color.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/imagemanager/primitives.h>
+#include <array>
 #include <cinttypes>
 #include <vector>
 
@@ -31,6 +32,10 @@ namespace ABI45_0_0React {
 struct AndroidTextInputSelectionStruct {
   int start;
   int end;
+
+  bool operator==(AndroidTextInputSelectionStruct const &rhs) const {
+    return start == rhs.start && end == rhs.end;
+  }
 };
 
 static inline void fromRawValue(
@@ -57,6 +62,10 @@ static inline std::string toString(
 struct AndroidTextInputTextShadowOffsetStruct {
   double width;
   double height;
+
+  bool operator==(AndroidTextInputTextShadowOffsetStruct const &rhs) const {
+    return width == rhs.width && height == rhs.height;
+  }
 };
 
 static inline void fromRawValue(
@@ -107,6 +116,15 @@ class AndroidTextInputProps final : public ViewProps, public BaseTextProps {
 
   folly::dynamic getDynamic() const;
 
+  /*
+   * Same as `getDynamic()`, but contains only props which differ from
+   * `prevProps`; all props if `prevProps` is `nullptr`. Float props which are
+   * NaN on both sides are considered equal.
+   * Meant to be called by the mounting layer with the props of the mounted
+   * view, when it sends an update; nothing is computed while parsing props.
+   */
+  folly::dynamic getDiffProps(AndroidTextInputProps const *prevProps) const;
+
 #pragma mark - Props
 
   const std::string autoComplete{};
@@ -183,6 +201,22 @@ class AndroidTextInputProps final : public ViewProps, public BaseTextProps {
 #if ABI45_0_0RN_DEBUG_STRING_CONVERTIBLE
   SharedDebugStringConvertibleList getDebugProps() const;
 #endif
+
+ private:
+  /*
+   * Values of `hasPadding*` flags, in the order of `hasPadding*` fields.
+   */
+  using PaddingPresence = std::array<bool, 9>;
+
+  static PaddingPresence parsePaddingPresence(
+      const AndroidTextInputProps &sourceProps,
+      const RawProps &rawProps);
+
+  AndroidTextInputProps(
+      const PropsParserContext &context,
+      const AndroidTextInputProps &sourceProps,
+      const RawProps &rawProps,
+      const PaddingPresence &paddingPresence);
 };
 
 } // namespace ABI45_0_0React
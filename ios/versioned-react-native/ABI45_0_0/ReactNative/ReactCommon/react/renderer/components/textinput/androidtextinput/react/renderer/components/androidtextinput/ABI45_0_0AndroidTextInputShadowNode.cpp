@@ -8,6 +8,7 @@
 #include "ABI45_0_0AndroidTextInputShadowNode.h"
 
 #include <fbjni/fbjni.h>
+#include <ABI45_0_0cxxreact/ABI45_0_0SystraceSection.h>
 #include <ABI45_0_0React/ABI45_0_0debug/ABI45_0_0React_native_assert.h>
 #include <ABI45_0_0React/ABI45_0_0jni/ReadableNativeMap.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/AttributedStringBox.h>
@@ -17,7 +18,11 @@
 #include <ABI45_0_0React/ABI45_0_0renderer/core/LayoutContext.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/core/conversions.h>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <utility>
+#include <vector>
 
 using namespace ABI45_0_0facebook::jni;
 
@@ -26,13 +31,54 @@ namespace ABI45_0_0React {
 
 extern const char AndroidTextInputComponentName[] = "AndroidTextInput";
 
+/*
+ * Inputs with fewer paragraphs than this are always measured as a whole:
+ * splitting them saves less than the extra measurements of a cold cache cost.
+ */
+static constexpr size_t kMinParagraphCountForChunkedMeasurement = 32;
+
+static size_t countParagraphs(AttributedString const &attributedString) {
+  auto count = size_t{1};
+  for (auto const &fragment : attributedString.getFragments()) {
+    count += std::count(fragment.string.begin(), fragment.string.end(), '\n');
+  }
+  return count;
+}
+
+AndroidTextInputShadowNode::AndroidTextInputShadowNode(
+    ShadowNode const &sourceShadowNode,
+    ShadowNodeFragment const &fragment)
+    : ConcreteViewShadowNode(sourceShadowNode, fragment),
+      contentMightHaveChanged_(
+          fragment.props || fragment.children || fragment.state),
+      paragraphCache_(static_cast<AndroidTextInputShadowNode const &>(
+                          sourceShadowNode)
+                          .paragraphCache_),
+      telemetry_(static_cast<AndroidTextInputShadowNode const &>(
+                     sourceShadowNode)
+                     .telemetry_) {}
+
+bool AndroidTextInputShadowNode::getContentMightHaveChanged() const {
+  return contentMightHaveChanged_;
+}
+
 void AndroidTextInputShadowNode::setContextContainer(
     ContextContainer *contextContainer) {
   ensureUnsealed();
   contextContainer_ = contextContainer;
 }
 
-AttributedString AndroidTextInputShadowNode::getAttributedString() const {
+AttributedString const &AndroidTextInputShadowNode::getAttributedString()
+    const {
+  auto const &layoutMetrics = getLayoutMetrics();
+  if (cachedAttributedString_.has_value() &&
+      cachedAttributedStringLayoutMetrics_ == layoutMetrics) {
+    return *cachedAttributedString_;
+  }
+
+  SystraceSection s("AndroidTextInputShadowNode::getAttributedString");
+  recordTelemetry(AndroidTextInputTelemetry::Counter::AttributedStringBuild);
+
   // Use BaseTextShadowNode to get attributed string from children
   auto childTextAttributes = TextAttributes::defaultTextAttributes();
   childTextAttributes.apply(getConcreteProps().textAttributes);
@@ -58,7 +104,10 @@ AttributedString AndroidTextInputShadowNode::getAttributedString() const {
     attributedString.prependFragment(fragment);
   }
 
-  return attributedString;
+  cachedAttributedString_ = std::move(attributedString);
+  cachedAttributedStringLayoutMetrics_ = layoutMetrics;
+  layoutHashedAttributedString_ = nullptr;
+  return *cachedAttributedString_;
 }
 
 // For measurement purposes, we want to make sure that there's at least a
@@ -96,11 +145,47 @@ void AndroidTextInputShadowNode::setTextLayoutManager(
   textLayoutManager_ = std::move(textLayoutManager);
 }
 
-AttributedString AndroidTextInputShadowNode::getMostRecentAttributedString()
-    const {
+void AndroidTextInputShadowNode::setMeasurementCache(
+    AndroidTextInputMeasurementCache::Shared measurementCache) {
+  ensureUnsealed();
+  measurementCache_ = std::move(measurementCache);
+}
+
+void AndroidTextInputShadowNode::setParagraphCache(
+    std::shared_ptr<AndroidTextInputMeasurementCache::ParagraphCache>
+        paragraphCache) {
+  ensureUnsealed();
+  paragraphCache_ = std::move(paragraphCache);
+}
+
+std::shared_ptr<AndroidTextInputMeasurementCache::ParagraphCache> const &
+AndroidTextInputShadowNode::getParagraphCache() const {
+  return paragraphCache_;
+}
+
+void AndroidTextInputShadowNode::setTelemetry(
+    AndroidTextInputTelemetry::SurfaceCounters::Shared telemetry) {
+  ensureUnsealed();
+  telemetry_ = std::move(telemetry);
+}
+
+AndroidTextInputTelemetry::SurfaceCounters::Shared const &
+AndroidTextInputShadowNode::getTelemetry() const {
+  return telemetry_;
+}
+
+void AndroidTextInputShadowNode::recordTelemetry(
+    AndroidTextInputTelemetry::Counter counter) const {
+  if (telemetry_) {
+    telemetry_->increment(counter);
+  }
+}
+
+AttributedString const &
+AndroidTextInputShadowNode::getMostRecentAttributedString() const {
   auto const &state = getStateData();
 
-  auto ABI45_0_0ReactTreeAttributedString = getAttributedString();
+  auto const &ABI45_0_0ReactTreeAttributedString = getAttributedString();
 
   // Sometimes the treeAttributedString will only differ from the state
   // not by inherent properties (string or prop attributes), but by the frame of
@@ -118,18 +203,30 @@ AttributedString AndroidTextInputShadowNode::getMostRecentAttributedString()
 void AndroidTextInputShadowNode::updateStateIfNeeded() {
   ensureUnsealed();
 
-  auto ABI45_0_0ReactTreeAttributedString = getAttributedString();
+  SystraceSection s("AndroidTextInputShadowNode::updateStateIfNeeded");
+
+  auto const &ABI45_0_0ReactTreeAttributedString = getAttributedString();
   auto const &state = getStateData();
 
   // Tree is often out of sync with the value of the TextInput.
   // This is by design - don't change the value of the TextInput in the State,
   // and therefore in Java, unless the tree itself changes.
-  if (state.ABI45_0_0ReactTreeAttributedString == ABI45_0_0ReactTreeAttributedString) {
+  auto comparisonStart = telemetry_ ? std::chrono::steady_clock::now()
+                                    : std::chrono::steady_clock::time_point{};
+  auto treeAttributedStringUnchanged =
+      state.ABI45_0_0ReactTreeAttributedString == ABI45_0_0ReactTreeAttributedString;
+  if (telemetry_) {
+    telemetry_->addStateUpdateComparisonTime(
+        std::chrono::steady_clock::now() - comparisonStart);
+  }
+  if (treeAttributedStringUnchanged) {
+    recordTelemetry(AndroidTextInputTelemetry::Counter::SkippedStateUpdate);
     return;
   }
 
   // If props event counter is less than what we already have in state, skip it
   if (getConcreteProps().mostRecentEventCount < state.mostRecentEventCount) {
+    recordTelemetry(AndroidTextInputTelemetry::Counter::SkippedStateUpdate);
     return;
   }
 
@@ -142,10 +239,16 @@ void AndroidTextInputShadowNode::updateStateIfNeeded() {
   defaultTextAttributes.apply(getConcreteProps().textAttributes);
 
   auto newEventCount =
-      (state.ABI45_0_0ReactTreeAttributedString == ABI45_0_0ReactTreeAttributedString
-           ? 0
-           : getConcreteProps().mostRecentEventCount);
-  auto newAttributedString = getMostRecentAttributedString();
+      (treeAttributedStringUnchanged ? 0
+                                     : getConcreteProps().mostRecentEventCount);
+  auto const &newAttributedString = getMostRecentAttributedString();
+
+  recordTelemetry(AndroidTextInputTelemetry::Counter::StateUpdate);
+  // `getMostRecentAttributedString` returns the string of the state itself if
+  // the text did not change, so no comparison is needed.
+  if (&newAttributedString == &state.attributedString) {
+    recordTelemetry(AndroidTextInputTelemetry::Counter::NoopStateUpdate);
+  }
 
   // Even if we're here and updating state, it may be only to update the layout
   // manager If that is the case, make sure we don't update text: pass in the
@@ -163,6 +266,69 @@ void AndroidTextInputShadowNode::updateStateIfNeeded() {
       state.defaultThemePaddingEnd,
       state.defaultThemePaddingTop,
       state.defaultThemePaddingBottom});
+  layoutHashedAttributedString_ = nullptr;
+}
+
+size_t AndroidTextInputShadowNode::getLayoutHash(
+    AttributedString const &attributedString) const {
+  if (layoutHashedAttributedString_ != &attributedString) {
+    layoutHash_ = AndroidTextInputMeasurementCache::getLayoutHash(
+        attributedString);
+    layoutHashedAttributedString_ = &attributedString;
+  }
+  return layoutHash_;
+}
+
+bool AndroidTextInputShadowNode::shouldMeasureParagraphs(
+    AttributedString const &attributedString) const {
+  auto const &props = getConcreteProps();
+  return paragraphCache_ && measurementCache_ &&
+      props.multiline && props.numberOfLines == 0 &&
+      props.paragraphAttributes.maximumNumberOfLines == 0 &&
+      countParagraphs(attributedString) >=
+      kMinParagraphCountForChunkedMeasurement;
+}
+
+Size AndroidTextInputShadowNode::measureParagraphs(
+    AttributedString const &attributedString,
+    ParagraphAttributes const &paragraphAttributes,
+    LayoutConstraints const &layoutConstraints) const {
+  SystraceSection s("AndroidTextInputShadowNode::measureParagraphs");
+
+  // Paragraphs are stacked vertically, so only the width is constrained;
+  // the total is clamped at the end.
+  auto paragraphLayoutConstraints = LayoutConstraints{
+      {0, 0},
+      {layoutConstraints.maximumSize.width,
+       std::numeric_limits<Float>::infinity()},
+      layoutConstraints.layoutDirection};
+
+  auto paragraphs = AndroidTextInputParagraph::split(attributedString);
+  // Room for the paragraphs of the previous layout and the edited ones, so a
+  // scan over all of them does not evict the entries it is about to reuse.
+  paragraphCache_->reserve(2 * paragraphs.size());
+
+  auto measure = [&](AttributedString const &paragraph) {
+    recordTelemetry(AndroidTextInputTelemetry::Counter::JNICall);
+    return textLayoutManager_->measure(
+        AttributedStringBox{paragraph},
+        paragraphAttributes,
+        paragraphLayoutConstraints);
+  };
+
+  auto size = Size{0, 0};
+  for (auto const &paragraph : paragraphs) {
+    auto measurement = measurementCache_->measureParagraph(
+        *paragraphCache_,
+        paragraph,
+        paragraphAttributes,
+        paragraphLayoutConstraints,
+        measure);
+    size.width = std::max(size.width, measurement.size.width);
+    size.height += measurement.size.height;
+  }
+
+  return layoutConstraints.clamp(size);
 }
 
 #pragma mark - LayoutableShadowNode
@@ -170,7 +336,12 @@ void AndroidTextInputShadowNode::updateStateIfNeeded() {
 Size AndroidTextInputShadowNode::measureContent(
     LayoutContext const &layoutContext,
     LayoutConstraints const &layoutConstraints) const {
+  SystraceSection s("AndroidTextInputShadowNode::measureContent");
+
   if (getStateData().cachedAttributedStringId != 0) {
+    recordTelemetry(
+        AndroidTextInputTelemetry::Counter::CachedAttributedStringMeasure);
+    recordTelemetry(AndroidTextInputTelemetry::Counter::JNICall);
     return textLayoutManager_
         ->measureCachedSpannableById(
             getStateData().cachedAttributedStringId,
@@ -184,21 +355,50 @@ Size AndroidTextInputShadowNode::measureContent(
   // during layout, but not during `measure`. If State is out-of-date in layout,
   // it's too late: measure will have already operated on old State. Thus, we
   // use the same value here that we *will* use in layout to update the state.
-  AttributedString attributedString = getMostRecentAttributedString();
-
-  if (attributedString.isEmpty()) {
-    attributedString = getPlaceholderAttributedString();
-  }
+  auto const &mostRecentAttributedString = getMostRecentAttributedString();
+  auto const placeholderAttributedString = mostRecentAttributedString.isEmpty()
+      ? getPlaceholderAttributedString()
+      : AttributedString{};
+  auto const &attributedString = mostRecentAttributedString.isEmpty()
+      ? placeholderAttributedString
+      : mostRecentAttributedString;
 
   if (attributedString.isEmpty() && getStateData().mostRecentEventCount != 0) {
     return {0, 0};
   }
 
-  return textLayoutManager_
+  recordTelemetry(AndroidTextInputTelemetry::Counter::Measure);
+
+  auto const &paragraphAttributes = getConcreteProps().paragraphAttributes;
+  if (shouldMeasureParagraphs(attributedString)) {
+    return measureParagraphs(
+        attributedString, paragraphAttributes, layoutConstraints);
+  }
+
+  auto measure = [&]() {
+    SystraceSection s("AndroidTextInputShadowNode::measureContent::JNI");
+    recordTelemetry(AndroidTextInputTelemetry::Counter::JNICall);
+    return textLayoutManager_->measure(
+        AttributedStringBox{attributedString},
+        paragraphAttributes,
+        layoutConstraints);
+  };
+
+  if (!measurementCache_) {
+    return measure().size;
+  }
+
+  // The placeholder string is temporary, so its hash is not memoized.
+  auto layoutHash = mostRecentAttributedString.isEmpty()
+      ? AndroidTextInputMeasurementCache::getLayoutHash(attributedString)
+      : getLayoutHash(mostRecentAttributedString);
+  return measurementCache_
       ->measure(
-          AttributedStringBox{attributedString},
-          getConcreteProps().paragraphAttributes,
-          layoutConstraints)
+          attributedString,
+          layoutHash,
+          paragraphAttributes,
+          layoutConstraints,
+          measure)
       .size;
 }
 
@@ -8,8 +8,10 @@
 #pragma once
 
 #include "ABI45_0_0AndroidTextInputEventEmitter.h"
+#include "ABI45_0_0AndroidTextInputMeasurementCache.h"
 #include "ABI45_0_0AndroidTextInputProps.h"
 #include "ABI45_0_0AndroidTextInputState.h"
+#include "ABI45_0_0AndroidTextInputTelemetry.h"
 
 #include <ABI45_0_0React/ABI45_0_0renderer/components/view/ConcreteViewShadowNode.h>
 #include <ABI45_0_0React/ABI45_0_0utils/ContextContainer.h>
@@ -39,12 +41,26 @@ class AndroidTextInputShadowNode final : public ConcreteViewShadowNode<
 
   using ConcreteViewShadowNode::ConcreteViewShadowNode;
 
+  AndroidTextInputShadowNode(
+      ShadowNode const &sourceShadowNode,
+      ShadowNodeFragment const &fragment);
+
+  /*
+   * Returns `false` if the node is a clone which has the same props,
+   * children and state as its source, so its measured content is the same.
+   * Freshly created nodes always return `true`.
+   */
+  bool getContentMightHaveChanged() const;
+
   void setContextContainer(ContextContainer *contextContainer);
 
   /*
    * Returns a `AttributedString` which represents text content of the node.
+   * The string is built once per node revision and then reused by
+   * measurement, layout and state updates; the reference is valid as long as
+   * the node is alive.
    */
-  AttributedString getAttributedString() const;
+  AttributedString const &getAttributedString() const;
   AttributedString getPlaceholderAttributedString() const;
 
   /*
@@ -54,6 +70,41 @@ class AndroidTextInputShadowNode final : public ConcreteViewShadowNode<
    */
   void setTextLayoutManager(SharedTextLayoutManager textLayoutManager);
 
+  /*
+   * Associates a shared measurement cache with the node.
+   * `measureContent` consults the cache before measuring with
+   * `TextLayoutManager`.
+   */
+  void setMeasurementCache(
+      AndroidTextInputMeasurementCache::Shared measurementCache);
+
+  /*
+   * Enables measuring large multiline inputs paragraph by paragraph.
+   * Every paragraph (a run of text between line breaks) is measured on its
+   * own and cached, so an edit only re-measures the paragraphs it touched
+   * instead of laying out the whole content again. The size of the content is
+   * the sum of the heights of its paragraphs. Only applies to multiline inputs
+   * without a limit on the number of lines, when a measurement cache is set.
+   * Measurements are cached in `paragraphCache` (of the surface of the node);
+   * without it (the default) inputs are measured as a whole. Clones inherit
+   * the cache of their source node.
+   */
+  void setParagraphCache(
+      std::shared_ptr<AndroidTextInputMeasurementCache::ParagraphCache>
+          paragraphCache);
+  std::shared_ptr<AndroidTextInputMeasurementCache::ParagraphCache> const &
+  getParagraphCache() const;
+
+  /*
+   * Associates telemetry counters of the surface with the node. Without them
+   * (the default) the node records no telemetry. Clones inherit the counters
+   * of their source node.
+   */
+  void setTelemetry(
+      AndroidTextInputTelemetry::SurfaceCounters::Shared telemetry);
+  AndroidTextInputTelemetry::SurfaceCounters::Shared const &getTelemetry()
+      const;
+
 #pragma mark - LayoutableShadowNode
 
   Size measureContent(
@@ -64,10 +115,20 @@ class AndroidTextInputShadowNode final : public ConcreteViewShadowNode<
  private:
   ContextContainer *contextContainer_{};
 
+  bool contentMightHaveChanged_{true};
+
   /**
    * Get the most up-to-date attributed string for measurement and State.
    */
-  AttributedString getMostRecentAttributedString() const;
+  AttributedString const &getMostRecentAttributedString() const;
+
+  /*
+   * Returns `AndroidTextInputMeasurementCache::getLayoutHash` of
+   * `attributedString`, which must be the string returned by
+   * `getMostRecentAttributedString()`. Yoga measures the node several times per
+   * layout pass, so the hash is memoized until that string changes.
+   */
+  size_t getLayoutHash(AttributedString const &attributedString) const;
 
   /*
    * Creates a `State` object (with `AttributedText` and
@@ -75,13 +136,48 @@ class AndroidTextInputShadowNode final : public ConcreteViewShadowNode<
    */
   void updateStateIfNeeded();
 
+  /*
+   * Returns `true` if `attributedString` should be measured paragraph by
+   * paragraph (see `setParagraphCache`).
+   */
+  bool shouldMeasureParagraphs(AttributedString const &attributedString) const;
+
+  /*
+   * Measures `attributedString` as a stack of separately measured (and
+   * cached) paragraphs.
+   */
+  Size measureParagraphs(
+      AttributedString const &attributedString,
+      ParagraphAttributes const &paragraphAttributes,
+      LayoutConstraints const &layoutConstraints) const;
+
+  /*
+   * Increments `counter` of the telemetry of the node, if any.
+   */
+  void recordTelemetry(AndroidTextInputTelemetry::Counter counter) const;
+
   SharedTextLayoutManager textLayoutManager_;
+  AndroidTextInputMeasurementCache::Shared measurementCache_;
+  std::shared_ptr<AndroidTextInputMeasurementCache::ParagraphCache>
+      paragraphCache_;
+  AndroidTextInputTelemetry::SurfaceCounters::Shared telemetry_;
 
   /*
    * Cached attributed string that represents the content of the subtree started
    * from the node.
+   * Fragments refer to the node via `ShadowView`, which carries its layout
+   * metrics, so the string is also rebuilt when those change (they are
+   * assigned between measurement and layout).
    */
   mutable butter::optional<AttributedString> cachedAttributedString_{};
+  mutable LayoutMetrics cachedAttributedStringLayoutMetrics_{};
+
+  /*
+   * String whose layout hash is memoized in `layoutHash_`: either the cached
+   * tree string or the one of the state. Reset whenever either is replaced.
+   */
+  mutable AttributedString const *layoutHashedAttributedString_{};
+  mutable size_t layoutHash_{0};
 };
 
 } // namespace ABI45_0_0React
@@ -7,6 +7,7 @@
 
 #include "ABI45_0_0AndroidTextInputState.h"
 
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/conversions.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/components/text/conversions.h>
 #include <ABI45_0_0React/ABI45_0_0renderer/debug/debugStringConvertibleUtils.h>
 
@@ -89,6 +90,27 @@ folly::dynamic AndroidTextInputState::getDynamic() const {
   }
   return newState;
 }
+
+MapBuffer AndroidTextInputState::getMapBuffer() const {
+  auto builder = MapBufferBuilder();
+  // See comment in `getDynamic`: with a `cachedAttributedStringId` Java
+  // already has all up-to-date information.
+  if (cachedAttributedStringId == 0) {
+    auto attributedStringMapBuffer = toMapBuffer(attributedString);
+    builder.putMapBuffer(
+        TX_STATE_KEY_ATTRIBUTED_STRING, attributedStringMapBuffer);
+    auto paragraphAttributesMapBuffer = toMapBuffer(paragraphAttributes);
+    builder.putMapBuffer(
+        TX_STATE_KEY_PARAGRAPH_ATTRIBUTES, paragraphAttributesMapBuffer);
+    builder.putInt(
+        TX_STATE_KEY_HASH,
+        static_cast<int>(std::hash<AttributedString>{}(attributedString)));
+    builder.putInt(
+        TX_STATE_KEY_MOST_RECENT_EVENT_COUNT,
+        static_cast<int>(mostRecentEventCount));
+  }
+  return builder.build();
+}
 #endif
 
 } // namespace ABI45_0_0React
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ABI45_0_0AndroidTextInputTelemetry.h"
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+AndroidTextInputTelemetry &AndroidTextInputTelemetry::shared() {
+  // Intentionally leaked to avoid destruction order issues at exit.
+  static auto &telemetry = *new AndroidTextInputTelemetry();
+  return telemetry;
+}
+
+AndroidTextInputTelemetry::SurfaceCounters::Shared
+AndroidTextInputTelemetry::getSurfaceCounters(SurfaceId surfaceId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &weakCounters = surfaceCounters_[surfaceId];
+  auto counters = weakCounters.lock();
+  if (counters) {
+    return counters;
+  }
+
+  // Counters are only requested for new shadow node families, so dropping
+  // counters of stopped surfaces here keeps the map small at little cost.
+  for (auto iterator = surfaceCounters_.begin();
+       iterator != surfaceCounters_.end();) {
+    if (iterator->first != surfaceId && iterator->second.expired()) {
+      iterator = surfaceCounters_.erase(iterator);
+    } else {
+      iterator++;
+    }
+  }
+
+  counters = std::make_shared<SurfaceCounters>();
+  weakCounters = counters;
+  return counters;
+}
+
+AndroidTextInputTelemetry::Counters AndroidTextInputTelemetry::getCounters(
+    SurfaceId surfaceId) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iterator = surfaceCounters_.find(surfaceId);
+  if (iterator == surfaceCounters_.end()) {
+    return {};
+  }
+  auto counters = iterator->second.lock();
+  return counters ? counters->snapshot() : Counters{};
+}
+
+std::unordered_map<SurfaceId, AndroidTextInputTelemetry::Counters>
+AndroidTextInputTelemetry::getAllCounters() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto result = std::unordered_map<SurfaceId, Counters>{};
+  for (auto const &pair : surfaceCounters_) {
+    if (auto counters = pair.second.lock()) {
+      result[pair.first] = counters->snapshot();
+    }
+  }
+  return result;
+}
+
+void AndroidTextInputTelemetry::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto const &pair : surfaceCounters_) {
+    if (auto counters = pair.second.lock()) {
+      counters->reset();
+    }
+  }
+}
+
+#pragma mark - SurfaceCounters
+
+void AndroidTextInputTelemetry::SurfaceCounters::increment(Counter counter) {
+  values_[static_cast<size_t>(counter)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+void AndroidTextInputTelemetry::SurfaceCounters::addStateUpdateComparisonTime(
+    std::chrono::nanoseconds duration) {
+  stateUpdateComparisonNanoseconds_.fetch_add(
+      duration.count(), std::memory_order_relaxed);
+}
+
+AndroidTextInputTelemetry::Counters
+AndroidTextInputTelemetry::SurfaceCounters::snapshot() const {
+  auto value = [&](Counter counter) {
+    return values_[static_cast<size_t>(counter)].load(
+        std::memory_order_relaxed);
+  };
+
+  auto counters = Counters{};
+  counters.measureCount = value(Counter::Measure);
+  counters.cachedAttributedStringMeasureCount =
+      value(Counter::CachedAttributedStringMeasure);
+  counters.jniCallCount = value(Counter::JNICall);
+  counters.attributedStringBuildCount = value(Counter::AttributedStringBuild);
+  counters.skippedStateUpdateCount = value(Counter::SkippedStateUpdate);
+  counters.stateUpdateCount = value(Counter::StateUpdate);
+  counters.noopStateUpdateCount = value(Counter::NoopStateUpdate);
+  counters.stateUpdateComparisonNanoseconds =
+      stateUpdateComparisonNanoseconds_.load(std::memory_order_relaxed);
+  return counters;
+}
+
+void AndroidTextInputTelemetry::SurfaceCounters::reset() {
+  for (auto &value : values_) {
+    value.store(0, std::memory_order_relaxed);
+  }
+  stateUpdateComparisonNanoseconds_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <ABI45_0_0React/ABI45_0_0renderer/core/ReactPrimitives.h>
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+/*
+ * Per-surface counters of text input layout work, meant to find screens
+ * which are text layout bound.
+ * Recording is disabled by default (see the
+ * "react_fabric:enable_text_input_telemetry_android" flag read by
+ * `AndroidTextInputComponentDescriptor`); nodes of a surface then have no
+ * `SurfaceCounters` and record nothing.
+ * Counters of a surface are shared by its shadow nodes and kept as long as
+ * any of them is alive: the component descriptor is not notified when a
+ * surface stops, so its counters are dropped when its last node is destroyed.
+ * They are cumulative until then (or until `reset()`) and readable at any
+ * time via `getCounters()`.
+ * The class is thread-safe; recording a value is an atomic increment.
+ */
+class AndroidTextInputTelemetry final {
+ public:
+  /*
+   * Snapshot of counters of one surface.
+   */
+  struct Counters {
+    /*
+     * `measureContent` calls that measured the attributed string and calls
+     * that took the `cachedAttributedStringId` fast path instead.
+     */
+    int64_t measureCount{0};
+    int64_t cachedAttributedStringMeasureCount{0};
+
+    /*
+     * Calls into Java (measurements with `TextLayoutManager` which were not
+     * answered from the measurement cache).
+     */
+    int64_t jniCallCount{0};
+
+    /*
+     * Attributed strings built from the ABI45_0_0React tree.
+     */
+    int64_t attributedStringBuildCount{0};
+
+    /*
+     * `updateStateIfNeeded` calls which skipped the update, updates which
+     * were committed, and committed updates that kept the text of the
+     * previous state (only the layout related parts of the state changed),
+     * i.e. no-ops for Java.
+     */
+    int64_t skippedStateUpdateCount{0};
+    int64_t stateUpdateCount{0};
+    int64_t noopStateUpdateCount{0};
+
+    /*
+     * Total time spent comparing attributed strings in
+     * `updateStateIfNeeded`.
+     */
+    int64_t stateUpdateComparisonNanoseconds{0};
+  };
+
+  enum class Counter {
+    Measure,
+    CachedAttributedStringMeasure,
+    JNICall,
+    AttributedStringBuild,
+    SkippedStateUpdate,
+    StateUpdate,
+    NoopStateUpdate,
+  };
+
+  /*
+   * Counters of one surface, shared by its shadow nodes.
+   */
+  class SurfaceCounters final {
+   public:
+    using Shared = std::shared_ptr<SurfaceCounters>;
+
+    /*
+     * Increments `counter`.
+     */
+    void increment(Counter counter);
+
+    /*
+     * Adds `duration` to the time spent comparing attributed strings.
+     */
+    void addStateUpdateComparisonTime(std::chrono::nanoseconds duration);
+
+    Counters snapshot() const;
+
+   private:
+    friend class AndroidTextInputTelemetry;
+
+    void reset();
+
+    std::atomic<int64_t>
+        values_[static_cast<size_t>(Counter::NoopStateUpdate) + 1]{};
+    std::atomic<int64_t> stateUpdateComparisonNanoseconds_{0};
+  };
+
+  static AndroidTextInputTelemetry &shared();
+
+  /*
+   * Returns counters of the surface, creating them if needed.
+   */
+  SurfaceCounters::Shared getSurfaceCounters(SurfaceId surfaceId);
+
+  /*
+   * Returns counters of the surface (all zeros for unknown surfaces) and
+   * counters of all surfaces.
+   */
+  Counters getCounters(SurfaceId surfaceId) const;
+  std::unordered_map<SurfaceId, Counters> getAllCounters() const;
+
+  /*
+   * Sets counters of all surfaces to zero.
+   */
+  void reset();
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<SurfaceId, std::weak_ptr<SurfaceCounters>>
+      surfaceCounters_;
+};
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string>
+
+#include <folly/dynamic.h>
+#include <gtest/gtest.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/components/androidtextinput/AndroidTextInputState.h>
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+static AndroidTextInputState makeState(std::string const &string) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = string;
+  fragment.textAttributes.fontSize = 14;
+  auto attributedString = AttributedString{};
+  attributedString.appendFragment(fragment);
+  return AndroidTextInputState(
+      1,
+      attributedString,
+      attributedString,
+      ParagraphAttributes{},
+      fragment.textAttributes,
+      ShadowView{},
+      1,
+      2,
+      3,
+      4);
+}
+
+TEST(AndroidTextInputStateTest, testUpdateFromJavaKeepsTheAttributedString) {
+  auto previousState = makeState("Hello");
+  auto data = folly::dynamic::object("mostRecentEventCount", 2)(
+      "opaqueCacheId", 42)("themePaddingTop", 8.0);
+
+  auto state = AndroidTextInputState(previousState, data);
+
+  EXPECT_EQ(state.mostRecentEventCount, 2);
+  EXPECT_EQ(state.cachedAttributedStringId, 42);
+  EXPECT_EQ(state.attributedString, previousState.attributedString);
+  EXPECT_EQ(
+      state.ABI45_0_0ReactTreeAttributedString,
+      previousState.ABI45_0_0ReactTreeAttributedString);
+  EXPECT_EQ(state.defaultThemePaddingStart, 1);
+  EXPECT_EQ(state.defaultThemePaddingEnd, 2);
+  EXPECT_EQ(state.defaultThemePaddingTop, 8);
+  EXPECT_EQ(state.defaultThemePaddingBottom, 4);
+}
+
+TEST(AndroidTextInputStateTest, testEmptyUpdateFromJavaKeepsEverything) {
+  auto previousState = makeState("Hello");
+
+  auto state = AndroidTextInputState(previousState, folly::dynamic::object());
+
+  EXPECT_EQ(state.mostRecentEventCount, previousState.mostRecentEventCount);
+  EXPECT_EQ(
+      state.cachedAttributedStringId, previousState.cachedAttributedStringId);
+  EXPECT_EQ(state.attributedString, previousState.attributedString);
+  EXPECT_EQ(state.defaultThemePaddingStart, 1);
+  EXPECT_EQ(state.defaultThemePaddingEnd, 2);
+  EXPECT_EQ(state.defaultThemePaddingTop, 3);
+  EXPECT_EQ(state.defaultThemePaddingBottom, 4);
+}
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/*
+ * Per-keystroke scenarios of <TextInput> on Android: the state update sent by
+ * Java (`AndroidTextInputState(previousState, data)`, which carries the event
+ * count and the id of the text cached in Java), its serialization back to
+ * Java (`getDynamic`) and the measurement of all inputs through
+ * `AndroidTextInputMeasurementCache`. Measuring itself goes through
+ * JNI, so the cache is given a constant measurement instead: the scenarios
+ * measure the cost around it, which is what a keystroke pays on cache hits.
+ * Every benchmark reports latency percentiles of single keystrokes and the
+ * number of allocations per keystroke (see `IterationRecorder`).
+ *
+ * Pass `--baseline=<file>` to fail on regressions against a previous run (see
+ * `ABI45_0_0BenchmarkSupport.cpp`).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <folly/dynamic.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/AttributedString.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/ParagraphAttributes.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/attributedstring/TextAttributes.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/components/androidtextinput/AndroidTextInputMeasurementCache.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/components/androidtextinput/AndroidTextInputState.h>
+#include <ABI45_0_0React/ABI45_0_0renderer/core/LayoutConstraints.h>
+
+#include "ABI45_0_0BenchmarkSupport.h"
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+#ifdef ANDROID
+
+static TextAttributes textAttributes() {
+  auto textAttributes = TextAttributes::defaultTextAttributes();
+  textAttributes.fontFamily = "Roboto";
+  textAttributes.fontSize = 14;
+  textAttributes.lineHeight = 20;
+  return textAttributes;
+}
+
+static AttributedString::Fragment makeFragment(std::string string) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = std::move(string);
+  fragment.textAttributes = textAttributes();
+  return fragment;
+}
+
+static AndroidTextInputState makeState(AttributedString attributedString) {
+  return AndroidTextInputState(
+      0,
+      attributedString,
+      attributedString,
+      ParagraphAttributes{},
+      textAttributes(),
+      ShadowView{},
+      NAN,
+      NAN,
+      NAN,
+      NAN);
+}
+
+static AttributedString makeLines(int count) {
+  auto attributedString = AttributedString{};
+  for (int i = 0; i < count; i++) {
+    attributedString.appendFragment(
+        makeFragment("The quick brown fox jumps " + std::to_string(i) + "\n"));
+  }
+  return attributedString;
+}
+
+/*
+ * Returns the state update Java sends for a keystroke. The typed text stays
+ * in the Java cache, so the attributed string of the state is kept.
+ */
+static folly::dynamic keystrokeData(AndroidTextInputState const &state) {
+  return folly::dynamic::object(
+      "mostRecentEventCount", state.mostRecentEventCount + 1)(
+      "opaqueCacheId", state.mostRecentEventCount + 1);
+}
+
+static TextMeasurement measurement() {
+  return TextMeasurement{{320, 20}, {}};
+}
+
+static LayoutConstraints layoutConstraints() {
+  return LayoutConstraints{
+      {0, 0}, {320, std::numeric_limits<Float>::infinity()}};
+}
+
+/*
+ * A form of 50 single line inputs: a keystroke updates the state of one of
+ * them and serializes it, then every input is measured again.
+ */
+static void BM_Form50InputsKeystroke(benchmark::State &state) {
+  constexpr auto kInputCount = 50;
+
+  auto cache = AndroidTextInputMeasurementCache{};
+  auto states = std::vector<AndroidTextInputState>{};
+  for (int i = 0; i < kInputCount; i++) {
+    auto attributedString = AttributedString{};
+    attributedString.appendFragment(makeFragment("value"));
+    states.push_back(makeState(attributedString));
+  }
+  auto constraints = layoutConstraints();
+
+  auto recorder = IterationRecorder{state};
+  auto keystroke = 0;
+  for (auto _ : state) {
+    auto &inputState = states[keystroke++ % kInputCount];
+
+    recorder.begin();
+    inputState = AndroidTextInputState(inputState, keystrokeData(inputState));
+    benchmark::DoNotOptimize(inputState.getDynamic());
+    for (auto const &input : states) {
+      benchmark::DoNotOptimize(cache.measure(
+          input.attributedString,
+          input.paragraphAttributes,
+          constraints,
+          measurement));
+    }
+    recorder.end();
+  }
+}
+BENCHMARK(BM_Form50InputsKeystroke)->Apply(scenarioBenchmark);
+
+/*
+ * An editor of 5,000 lines measured paragraph by paragraph: a keystroke
+ * updates and serializes the state, then every paragraph is measured again.
+ */
+static void BM_Editor5000LinesKeystroke(benchmark::State &state) {
+  constexpr auto kLineCount = 5000;
+
+  auto cache = AndroidTextInputMeasurementCache{};
+  auto paragraphCache = cache.getParagraphCache(1);
+  auto inputState = makeState(makeLines(kLineCount));
+  auto constraints = layoutConstraints();
+  auto measureParagraph = [](AttributedString const &) {
+    return measurement();
+  };
+
+  auto recorder = IterationRecorder{state};
+  for (auto _ : state) {
+    recorder.begin();
+    inputState = AndroidTextInputState(inputState, keystrokeData(inputState));
+    benchmark::DoNotOptimize(inputState.getDynamic());
+
+    auto paragraphs =
+        AndroidTextInputParagraph::split(inputState.attributedString);
+    paragraphCache->reserve(2 * paragraphs.size());
+    for (auto const &paragraph : paragraphs) {
+      benchmark::DoNotOptimize(cache.measureParagraph(
+          *paragraphCache,
+          paragraph,
+          inputState.paragraphAttributes,
+          constraints,
+          measureParagraph));
+    }
+    recorder.end();
+  }
+}
+BENCHMARK(BM_Editor5000LinesKeystroke)->Apply(scenarioBenchmark);
+
+/*
+ * Serialization of the state sent to Java after a change from the ABI45_0_0React tree.
+ */
+static void BM_StateGetDynamic(benchmark::State &state) {
+  auto inputState = makeState(makeLines((int)state.range(0)));
+
+  auto recorder = IterationRecorder{state};
+  for (auto _ : state) {
+    recorder.begin();
+    benchmark::DoNotOptimize(inputState.getDynamic());
+    recorder.end();
+  }
+}
+BENCHMARK(BM_StateGetDynamic)
+    ->Apply(scenarioBenchmark)
+    ->ArgName("lines")
+    ->Arg(1)
+    ->Arg(50)
+    ->Arg(5000);
+
+#endif
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/*
+ * Allocation counting, latency percentiles and the `main` of the benchmarks.
+ * Compiled into the benchmark binary only: it replaces the global
+ * `operator new` of the binary to count allocations.
+ *
+ * Besides the flags of Google Benchmark, the binary accepts
+ * `--baseline=<file>`: results are compared against a previous run saved with
+ * `--benchmark_out=<file> --benchmark_out_format=json` (on the same device),
+ * and the binary exits with 1 if a benchmark got slower by more than
+ * `--max_regression=<fraction>` (0.1 by default) or allocates more per
+ * iteration than it did. The results of the current run are read back from
+ * its own `--benchmark_out` file, which is then required; the console output
+ * still follows `--benchmark_format`.
+ */
+
+#include "ABI45_0_0BenchmarkSupport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include <folly/json.h>
+
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+  return operator new(size);
+}
+
+void *operator new(size_t size, std::nothrow_t const &) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](size_t size, std::nothrow_t const &) noexcept {
+  return operator new(size, std::nothrow);
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+size_t allocationCount() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+constexpr size_t IterationRecorder::kMaxRecordedLatencies;
+
+IterationRecorder::IterationRecorder(benchmark::State &state)
+    : state_(state) {
+  // The run's iteration count is known up front, recording must not allocate
+  // in the middle of the measured iterations.
+  auto iterations = static_cast<size_t>(std::max<benchmark::IterationCount>(
+      state.max_iterations, 1));
+  stride_ = (iterations + kMaxRecordedLatencies - 1) / kMaxRecordedLatencies;
+  latencies_.reserve((iterations + stride_ - 1) / stride_);
+}
+
+IterationRecorder::~IterationRecorder() {
+  if (latencies_.empty()) {
+    return;
+  }
+
+  std::sort(latencies_.begin(), latencies_.end());
+  auto percentile = [&](double fraction) {
+    auto index = static_cast<size_t>(
+        std::ceil(fraction * static_cast<double>(latencies_.size())));
+    return latencies_[std::min(index, latencies_.size()) - 1] * 1e6;
+  };
+  state_.counters["p50"] = percentile(0.5);
+  state_.counters["p90"] = percentile(0.9);
+  state_.counters["p99"] = percentile(0.99);
+  state_.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations_), benchmark::Counter::kAvgIterations);
+}
+
+void IterationRecorder::begin() {
+  startAllocationCount_ = allocationCount();
+  start_ = std::chrono::steady_clock::now();
+}
+
+void IterationRecorder::end() {
+  auto end = std::chrono::steady_clock::now();
+  allocations_ += allocationCount() - startAllocationCount_;
+
+  auto seconds = std::chrono::duration<double>(end - start_).count();
+  state_.SetIterationTime(seconds);
+  if (iteration_++ % stride_ == 0) {
+    latencies_.push_back(seconds);
+  }
+}
+
+void scenarioBenchmark(benchmark::internal::Benchmark *benchmark) {
+  benchmark->UseManualTime()->Unit(benchmark::kMicrosecond);
+}
+
+namespace {
+
+struct BenchmarkResult {
+  double realTime;
+  std::string timeUnit;
+  double allocations;
+};
+
+using BenchmarkResults = std::unordered_map<std::string, BenchmarkResult>;
+
+/*
+ * Reads the results saved by the JSON reporter of Google Benchmark into
+ * `results`. Returns `false` if the file cannot be read.
+ */
+bool readResults(std::string const &path, BenchmarkResults &results) {
+  auto file = std::ifstream(path);
+  if (!file) {
+    std::cerr << "Cannot read benchmark results " << path << std::endl;
+    return false;
+  }
+  auto contents = std::stringstream{};
+  contents << file.rdbuf();
+  auto json = folly::parseJson(contents.str());
+
+  for (auto const &entry : json["benchmarks"]) {
+    if (entry.getDefault("error_occurred", false).asBool()) {
+      continue;
+    }
+    auto allocations = entry.get_ptr("allocs");
+    results[entry["name"].asString()] = BenchmarkResult{
+        entry["real_time"].asDouble(),
+        entry.getDefault("time_unit", "ns").asString(),
+        allocations ? allocations->asDouble() : NAN};
+  }
+  return true;
+}
+
+/*
+ * Returns the number of regressions found.
+ */
+int compareWithBaseline(
+    BenchmarkResults const &results,
+    BenchmarkResults const &baseline,
+    double maxRegression) {
+  auto regressions = 0;
+  for (auto const &entry : baseline) {
+    auto const &name = entry.first;
+    auto result = results.find(name);
+    if (result == results.end()) {
+      continue;
+    }
+
+    auto const &current = result->second;
+    auto const &previous = entry.second;
+    if (previous.timeUnit != current.timeUnit) {
+      std::cerr << name << ": time unit differs from the baseline, skipped"
+                << std::endl;
+      continue;
+    }
+
+    auto change = (current.realTime - previous.realTime) / previous.realTime;
+    if (change > maxRegression) {
+      std::cerr << "REGRESSION " << name << ": " << current.realTime << " "
+                << current.timeUnit << " vs " << previous.realTime << " ("
+                << std::lround(change * 100) << "%)" << std::endl;
+      regressions++;
+    }
+
+    if (!std::isnan(previous.allocations) &&
+        !std::isnan(current.allocations) &&
+        current.allocations > previous.allocations + 0.5) {
+      std::cerr << "REGRESSION " << name << ": " << current.allocations
+                << " allocations per iteration vs " << previous.allocations
+                << std::endl;
+      regressions++;
+    }
+  }
+  return regressions;
+}
+
+/*
+ * Returns the value of `--<name>=<value>` in `argv`, or an empty string.
+ */
+std::string flagValue(int argc, char **argv, std::string const &name) {
+  auto prefix = "--" + name + "=";
+  auto value = std::string{};
+  for (auto i = 1; i < argc; i++) {
+    if (std::strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+      value = argv[i] + prefix.size();
+    }
+  }
+  return value;
+}
+
+} // namespace
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
+
+int main(int argc, char **argv) {
+  using namespace ABI45_0_0facebook::ABI45_0_0React;
+
+  auto baselinePath = std::string{};
+  auto maxRegression = 0.1;
+
+  // Takes own flags out before Google Benchmark rejects them.
+  auto count = 1;
+  for (auto i = 1; i < argc; i++) {
+    if (std::strncmp(argv[i], "--baseline=", 11) == 0) {
+      baselinePath = argv[i] + 11;
+    } else if (std::strncmp(argv[i], "--max_regression=", 17) == 0) {
+      maxRegression = std::atof(argv[i] + 17);
+    } else {
+      argv[count++] = argv[i];
+    }
+  }
+  argc = count;
+
+  // The gate reads the results of this run back from the file reporter, so
+  // the display reporter stays the one chosen by `--benchmark_format`.
+  auto outPath = flagValue(argc, argv, "benchmark_out");
+  auto outFormat = flagValue(argc, argv, "benchmark_out_format");
+  if (!baselinePath.empty() &&
+      (outPath.empty() || (!outFormat.empty() && outFormat != "json"))) {
+    std::cerr << "--baseline needs --benchmark_out=<file> in the JSON format"
+              << std::endl;
+    return 1;
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  if (baselinePath.empty()) {
+    return 0;
+  }
+  auto results = BenchmarkResults{};
+  auto baseline = BenchmarkResults{};
+  if (!readResults(outPath, results) || !readResults(baselinePath, baseline)) {
+    return 1;
+  }
+  auto regressions = compareWithBaseline(results, baseline, maxRegression);
+  std::cerr << regressions << " regression(s) against " << baselinePath
+            << std::endl;
+  return regressions == 0 ? 0 : 1;
+}
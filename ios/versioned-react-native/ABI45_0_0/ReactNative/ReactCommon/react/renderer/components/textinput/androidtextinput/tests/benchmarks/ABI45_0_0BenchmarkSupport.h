@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+namespace ABI45_0_0facebook {
+namespace ABI45_0_0React {
+
+/*
+ * Returns the number of heap allocations (calls of `operator new`) made by
+ * the process so far. Counted only in benchmark binaries, which replace the
+ * global `operator new` (see `ABI45_0_0BenchmarkSupport.cpp`).
+ */
+size_t allocationCount();
+
+/*
+ * Measures every iteration of a scenario benchmark and reports, besides the
+ * timings, the latency percentiles of single iterations (`p50`, `p90`, `p99`,
+ * in microseconds) and the number of allocations per iteration (`allocs`).
+ * Only the time between `begin()` and `end()` is measured, so the benchmark
+ * has to be registered with `UseManualTime()` (see `scenarioBenchmark`).
+ * Percentiles of runs longer than `kMaxRecordedLatencies` iterations are
+ * computed from evenly spaced iterations.
+ */
+class IterationRecorder final {
+ public:
+  explicit IterationRecorder(benchmark::State &state);
+  ~IterationRecorder();
+
+  void begin();
+  void end();
+
+ private:
+  static constexpr size_t kMaxRecordedLatencies = 64 * 1024;
+
+  benchmark::State &state_;
+  std::vector<double> latencies_;
+  size_t stride_{1};
+  size_t iteration_{0};
+  std::chrono::steady_clock::time_point start_;
+  size_t startAllocationCount_{0};
+  size_t allocations_{0};
+};
+
+/*
+ * Registration options shared by scenario benchmarks.
+ */
+void scenarioBenchmark(benchmark::internal::Benchmark *benchmark);
+
+} // namespace ABI45_0_0React
+} // namespace ABI45_0_0facebook
@@ -0,0 +1,46 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <Foundation/Foundation.h>
+
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXExportedModule.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Method exported by a legacy module, with its selector and signature resolved up front.
+ */
+@interface ABI45_0_0EXExportedMethod : NSObject
+
+@property (nonatomic, strong, readonly) NSString *name;
+@property (nonatomic, readonly) SEL selector;
+@property (nonatomic, strong, readonly, nullable) NSMethodSignature *signature;
+/**
+ Number of JS arguments, i.e. without the promise resolver and rejecter.
+ */
+@property (nonatomic, readonly) NSUInteger argumentsCount;
+
+@end
+
+/**
+ Immutable table of methods exported by a legacy module class.
+ Tables are built once per class for the lifetime of the process and shared by all bridges,
+ so the methods are enumerated and their selectors are parsed only once.
+ Method keys are indices in the list of methods sorted by name, thus they are stable
+ across launches as long as the set of exported methods of the class doesn't change.
+ */
+@interface ABI45_0_0EXExportedMethodsTable : NSObject
+
+/**
+ Infos of exported methods (`key`, `name` and `argumentsCount`) that are exported to JS, sorted by key.
+ */
+@property (nonatomic, strong, readonly) NSArray<NSDictionary<NSString *, id> *> *methodsInfo;
+
++ (instancetype)tableForExportedModule:(ABI45_0_0EXExportedModule *)exportedModule;
+
+- (nullable NSString *)methodNameForKey:(NSNumber *)key;
+- (nullable ABI45_0_0EXExportedMethod *)methodForKey:(NSUInteger)key;
+- (nullable ABI45_0_0EXExportedMethod *)methodForName:(NSString *)name;
+
+@end
+
+NS_ASSUME_NONNULL_END
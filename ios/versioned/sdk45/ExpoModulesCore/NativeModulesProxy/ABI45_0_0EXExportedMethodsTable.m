@@ -0,0 +1,129 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <os/lock.h>
+
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXExportedMethodsTable.h>
+
+static NSString *methodInfoKeyKey = @"key";
+static NSString *methodInfoNameKey = @"name";
+static NSString *methodInfoArgumentsCountKey = @"argumentsCount";
+
+@implementation ABI45_0_0EXExportedMethod
+
+- (instancetype)initWithName:(NSString *)name selectorName:(NSString *)selectorName moduleClass:(Class)moduleClass
+{
+  if (self = [super init]) {
+    _name = name;
+    _selector = NSSelectorFromString(selectorName);
+    _signature = [moduleClass instanceMethodSignatureForSelector:_selector];
+    _argumentsCount = [ABI45_0_0EXExportedMethod argumentsCountOfSelectorName:selectorName];
+  }
+  return self;
+}
+
+/**
+ Returns the number of JS arguments of the exported method with given selector name,
+ i.e. the number of its arguments without the promise resolver and rejecter.
+ */
++ (NSUInteger)argumentsCountOfSelectorName:(NSString *)selectorName
+{
+  NSUInteger colonsCount = 0;
+  for (const char *character = [selectorName UTF8String]; *character != '\0'; character++) {
+    if (*character == ':') {
+      colonsCount++;
+    }
+  }
+  return colonsCount >= 2 ? colonsCount - 2 : 0;
+}
+
+@end
+
+@interface ABI45_0_0EXExportedMethodsTable ()
+
+@property (nonatomic, strong) NSArray<ABI45_0_0EXExportedMethod *> *methods;
+@property (nonatomic, strong) NSDictionary<NSString *, ABI45_0_0EXExportedMethod *> *methodsByName;
+
+@end
+
+@implementation ABI45_0_0EXExportedMethodsTable
+
+- (instancetype)initWithExportedMethods:(NSDictionary<NSString *, NSString *> *)exportedMethods moduleClass:(Class)moduleClass
+{
+  if (self = [super init]) {
+    NSArray<NSString *> *methodsNames = [[exportedMethods allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray<ABI45_0_0EXExportedMethod *> *methods = [NSMutableArray arrayWithCapacity:methodsNames.count];
+    NSMutableDictionary<NSString *, ABI45_0_0EXExportedMethod *> *methodsByName = [NSMutableDictionary dictionaryWithCapacity:methodsNames.count];
+    NSMutableArray<NSDictionary<NSString *, id> *> *methodsInfo = [NSMutableArray arrayWithCapacity:methodsNames.count];
+
+    [methodsNames enumerateObjectsUsingBlock:^(NSString * _Nonnull methodName, NSUInteger index, BOOL * _Nonnull stop) {
+      ABI45_0_0EXExportedMethod *method = [[ABI45_0_0EXExportedMethod alloc] initWithName:methodName
+                                                                selectorName:exportedMethods[methodName]
+                                                                 moduleClass:moduleClass];
+      [methods addObject:method];
+      methodsByName[methodName] = method;
+      [methodsInfo addObject:@{
+        methodInfoKeyKey: @(index),
+        methodInfoNameKey: methodName,
+        methodInfoArgumentsCountKey: @(method.argumentsCount)
+      }];
+    }];
+
+    _methods = methods;
+    _methodsByName = methodsByName;
+    _methodsInfo = methodsInfo;
+  }
+  return self;
+}
+
++ (instancetype)tableForExportedModule:(ABI45_0_0EXExportedModule *)exportedModule
+{
+  static NSMapTable<Class, ABI45_0_0EXExportedMethodsTable *> *tables;
+  static os_unfair_lock lock = OS_UNFAIR_LOCK_INIT;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    tables = [NSMapTable strongToStrongObjectsMapTable];
+  });
+
+  Class moduleClass = [exportedModule class];
+
+  os_unfair_lock_lock(&lock);
+  ABI45_0_0EXExportedMethodsTable *table = [tables objectForKey:moduleClass];
+  os_unfair_lock_unlock(&lock);
+
+  if (table) {
+    return table;
+  }
+
+  // Built outside of the lock, as enumerating exported methods walks the class' methods.
+  // If another thread has built the table in the meantime, the first one wins.
+  ABI45_0_0EXExportedMethodsTable *newTable = [[ABI45_0_0EXExportedMethodsTable alloc] initWithExportedMethods:[exportedModule getExportedMethods]
+                                                                                                moduleClass:moduleClass];
+
+  os_unfair_lock_lock(&lock);
+  table = [tables objectForKey:moduleClass];
+  if (!table) {
+    table = newTable;
+    [tables setObject:table forKey:moduleClass];
+  }
+  os_unfair_lock_unlock(&lock);
+
+  return table;
+}
+
+- (nullable NSString *)methodNameForKey:(NSNumber *)key
+{
+  NSInteger index = [key integerValue];
+  return index >= 0 ? [self methodForKey:(NSUInteger)index].name : nil;
+}
+
+- (nullable ABI45_0_0EXExportedMethod *)methodForKey:(NSUInteger)key
+{
+  return key < _methods.count ? _methods[key] : nil;
+}
+
+- (nullable ABI45_0_0EXExportedMethod *)methodForName:(NSString *)name
+{
+  return _methodsByName[name];
+}
+
+@end
@@ -0,0 +1,54 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, ABI45_0_0EXModulesExecutorPriority) {
+  // Calls whose results are awaited by the UI, e.g. reads done when a screen mounts.
+  ABI45_0_0EXModulesExecutorPriorityUserInteractive = 0,
+  // Long-running calls that nobody waits for, e.g. uploads or cache cleanups.
+  ABI45_0_0EXModulesExecutorPriorityBackground = 1,
+};
+
+// Protocol that modules conform to in order to run their methods on the shared executor, when it's enabled,
+// instead of their method queue, and to change how the executor runs them. Methods of modules that don't conform
+// to the protocol keep running on the modules' method queues, as their state may be confined to those queues.
+@protocol ABI45_0_0EXModulesExecutorClient <NSObject>
+
+@optional
+
+// Whether methods of the module can run concurrently with each other. Defaults to `NO`,
+// in which case they run one by one, in the order they were called, as on a serial method queue.
+- (BOOL)allowsConcurrentMethodCalls;
+
+// Priority of calls to the method with given name. Defaults to `ABI45_0_0EXModulesExecutorPriorityUserInteractive`.
+- (ABI45_0_0EXModulesExecutorPriority)priorityOfMethod:(NSString *)methodName;
+
+@end
+
+// Executor of module method calls shared by all the modules, used in place of their own method queues.
+// Each priority has its own lane with a bounded number of workers running on threads of the corresponding QoS class,
+// so calls of background work cannot starve latency-sensitive ones and the number of threads doesn't grow
+// with the number of modules. Calls sharing a serial key run one at a time, in the submission order.
+// The class is thread-safe.
+@interface ABI45_0_0EXModulesExecutor : NSObject
+
++ (instancetype)sharedExecutor;
+
+- (instancetype)initWithMaxConcurrentCallsCount:(NSUInteger)userInteractiveCount
+                backgroundMaxConcurrentCallsCount:(NSUInteger)backgroundCount NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (void)executeBlock:(dispatch_block_t)block
+            priority:(ABI45_0_0EXModulesExecutorPriority)priority
+           serialKey:(nullable NSString *)serialKey;
+
+// Returns metrics of each lane, keyed by the priority name (`userInteractive` and `background`):
+// current queue depth and running calls count, their maximums, number of completed calls
+// and average and maximum times (in milliseconds) that calls waited in the queue and took to run.
+- (NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)metrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,209 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <os/lock.h>
+#import <time.h>
+
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXModulesExecutor.h>
+
+static const NSUInteger lanesCount = 2;
+
+@interface ABI45_0_0EXModulesExecutorTask : NSObject
+
+@property (nonatomic, copy) dispatch_block_t block;
+@property (nonatomic) ABI45_0_0EXModulesExecutorPriority priority;
+@property (nonatomic, copy, nullable) NSString *serialKey;
+@property (nonatomic) uint64_t enqueueTime;
+
+@end
+
+@implementation ABI45_0_0EXModulesExecutorTask
+@end
+
+/**
+ State of the lane of one priority. Guarded by the executor's lock.
+ */
+typedef struct {
+  dispatch_queue_t workersQueue;
+  NSUInteger maxWorkersCount;
+  NSUInteger workersCount;
+  NSUInteger maxQueueDepth;
+  NSUInteger maxRunningCount;
+  uint64_t completedCount;
+  uint64_t totalWaitTime;
+  uint64_t maxWaitTime;
+  uint64_t totalRunTime;
+  uint64_t maxRunTime;
+} ABI45_0_0EXModulesExecutorLane;
+
+@interface ABI45_0_0EXModulesExecutor ()
+{
+  os_unfair_lock _lock;
+  ABI45_0_0EXModulesExecutorLane _lanes[lanesCount];
+}
+
+// Tasks ready to run, per lane.
+@property (nonatomic, strong) NSArray<NSMutableArray<ABI45_0_0EXModulesExecutorTask *> *> *pendingTasks;
+
+// Tasks waiting for the running task with the same serial key to finish.
+// A key is present as long as one of its tasks is pending or running.
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<ABI45_0_0EXModulesExecutorTask *> *> *serializedTasks;
+
+@end
+
+@implementation ABI45_0_0EXModulesExecutor
+
++ (instancetype)sharedExecutor
+{
+  static ABI45_0_0EXModulesExecutor *sharedExecutor;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSUInteger processorsCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    sharedExecutor = [[ABI45_0_0EXModulesExecutor alloc] initWithMaxConcurrentCallsCount:MAX(processorsCount, 2)
+                                                    backgroundMaxConcurrentCallsCount:MAX(processorsCount / 2, 1)];
+  });
+  return sharedExecutor;
+}
+
+- (instancetype)initWithMaxConcurrentCallsCount:(NSUInteger)userInteractiveCount
+                backgroundMaxConcurrentCallsCount:(NSUInteger)backgroundCount
+{
+  if (self = [super init]) {
+    _lock = OS_UNFAIR_LOCK_INIT;
+    // Latency-sensitive calls still run below the QoS of the main thread that renders the UI.
+    _lanes[ABI45_0_0EXModulesExecutorPriorityUserInteractive] = (ABI45_0_0EXModulesExecutorLane){
+      .workersQueue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+      .maxWorkersCount = MAX(userInteractiveCount, 1),
+    };
+    _lanes[ABI45_0_0EXModulesExecutorPriorityBackground] = (ABI45_0_0EXModulesExecutorLane){
+      .workersQueue = dispatch_get_global_queue(QOS_CLASS_BACKGROUND, 0),
+      .maxWorkersCount = MAX(backgroundCount, 1),
+    };
+    _pendingTasks = @[[NSMutableArray array], [NSMutableArray array]];
+    _serializedTasks = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)executeBlock:(dispatch_block_t)block
+            priority:(ABI45_0_0EXModulesExecutorPriority)priority
+           serialKey:(nullable NSString *)serialKey
+{
+  ABI45_0_0EXModulesExecutorTask *task = [ABI45_0_0EXModulesExecutorTask new];
+  task.block = block;
+  task.priority = priority == ABI45_0_0EXModulesExecutorPriorityBackground ? priority : ABI45_0_0EXModulesExecutorPriorityUserInteractive;
+  task.serialKey = serialKey;
+  task.enqueueTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+
+  os_unfair_lock_lock(&_lock);
+  if (serialKey != nil) {
+    NSMutableArray<ABI45_0_0EXModulesExecutorTask *> *serializedTasks = _serializedTasks[serialKey];
+    if (serializedTasks != nil) {
+      // Another call with the same key is pending or running, this one is scheduled when that one finishes.
+      [serializedTasks addObject:task];
+      os_unfair_lock_unlock(&_lock);
+      return;
+    }
+    _serializedTasks[serialKey] = [NSMutableArray array];
+  }
+  [self enqueueTaskLocked:task];
+  os_unfair_lock_unlock(&_lock);
+}
+
+- (NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)metrics
+{
+  NSMutableDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *metrics = [NSMutableDictionary dictionary];
+
+  os_unfair_lock_lock(&_lock);
+  for (NSUInteger priority = 0; priority < lanesCount; priority++) {
+    ABI45_0_0EXModulesExecutorLane *lane = &_lanes[priority];
+    double completedCount = MAX(lane->completedCount, 1);
+    metrics[priority == ABI45_0_0EXModulesExecutorPriorityBackground ? @"background" : @"userInteractive"] = @{
+      @"queueDepth": @(_pendingTasks[priority].count),
+      @"maxQueueDepth": @(lane->maxQueueDepth),
+      @"runningCount": @(lane->workersCount),
+      @"maxRunningCount": @(lane->maxRunningCount),
+      @"completedCount": @(lane->completedCount),
+      @"averageWaitTime": @(lane->totalWaitTime / completedCount / NSEC_PER_MSEC),
+      @"maxWaitTime": @((double)lane->maxWaitTime / NSEC_PER_MSEC),
+      @"averageRunTime": @(lane->totalRunTime / completedCount / NSEC_PER_MSEC),
+      @"maxRunTime": @((double)lane->maxRunTime / NSEC_PER_MSEC),
+    };
+  }
+  os_unfair_lock_unlock(&_lock);
+
+  return metrics;
+}
+
+#pragma mark - Privates
+
+/**
+ Adds the task to its lane's queue and starts a worker if the lane has not reached its limit.
+ Must be called with `_lock` held.
+ */
+- (void)enqueueTaskLocked:(ABI45_0_0EXModulesExecutorTask *)task
+{
+  ABI45_0_0EXModulesExecutorLane *lane = &_lanes[task.priority];
+  NSMutableArray<ABI45_0_0EXModulesExecutorTask *> *pendingTasks = _pendingTasks[task.priority];
+
+  [pendingTasks addObject:task];
+  lane->maxQueueDepth = MAX(lane->maxQueueDepth, pendingTasks.count);
+
+  if (lane->workersCount < lane->maxWorkersCount) {
+    lane->workersCount++;
+    lane->maxRunningCount = MAX(lane->maxRunningCount, lane->workersCount);
+    ABI45_0_0EXModulesExecutorPriority priority = task.priority;
+    dispatch_async(lane->workersQueue, ^{
+      [self runWorkerOfLane:priority];
+    });
+  }
+}
+
+/**
+ Runs tasks of the lane until its queue is empty.
+ */
+- (void)runWorkerOfLane:(ABI45_0_0EXModulesExecutorPriority)priority
+{
+  ABI45_0_0EXModulesExecutorLane *lane = &_lanes[priority];
+  NSMutableArray<ABI45_0_0EXModulesExecutorTask *> *pendingTasks = _pendingTasks[priority];
+
+  while (YES) {
+    os_unfair_lock_lock(&_lock);
+    ABI45_0_0EXModulesExecutorTask *task = pendingTasks.firstObject;
+    if (task == nil) {
+      lane->workersCount--;
+      os_unfair_lock_unlock(&_lock);
+      return;
+    }
+    [pendingTasks removeObjectAtIndex:0];
+    os_unfair_lock_unlock(&_lock);
+
+    uint64_t startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    @autoreleasepool {
+      task.block();
+    }
+    uint64_t endTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+
+    os_unfair_lock_lock(&_lock);
+    uint64_t waitTime = startTime - task.enqueueTime;
+    uint64_t runTime = endTime - startTime;
+    lane->completedCount++;
+    lane->totalWaitTime += waitTime;
+    lane->maxWaitTime = MAX(lane->maxWaitTime, waitTime);
+    lane->totalRunTime += runTime;
+    lane->maxRunTime = MAX(lane->maxRunTime, runTime);
+
+    if (task.serialKey != nil) {
+      NSMutableArray<ABI45_0_0EXModulesExecutorTask *> *serializedTasks = _serializedTasks[task.serialKey];
+      ABI45_0_0EXModulesExecutorTask *nextTask = serializedTasks.firstObject;
+      if (nextTask != nil) {
+        [serializedTasks removeObjectAtIndex:0];
+        [self enqueueTaskLocked:nextTask];
+      } else {
+        [_serializedTasks removeObjectForKey:task.serialKey];
+      }
+    }
+    os_unfair_lock_unlock(&_lock);
+  }
+}
+
+@end
@@ -0,0 +1,33 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Measures steps of setting up the modules at startup. Each measured step is emitted as an `os_signpost` interval
+ (subsystem `dev.expo.modules`, category `Startup`), so it shows up in Instruments, and is recorded to the report.
+ The class is thread-safe.
+ */
+@interface ABI45_0_0EXModulesStartupProfiler : NSObject
+
+/**
+ Measures the step that is not specific to any module.
+ */
+- (void)measureStep:(NSString *)stepName block:(NS_NOESCAPE dispatch_block_t)block;
+
+/**
+ Measures the part of the step that concerns the module with given name.
+ */
+- (void)measureStep:(NSString *)stepName ofModule:(NSString *)moduleName block:(NS_NOESCAPE dispatch_block_t)block;
+
+/**
+ Returns the report of measured steps: a `steps` array of `{ name, startTime, duration }` in the order the steps started
+ and a `modules` dictionary with durations of steps per module, e.g. `{ ExpoCamera: { createViewManagerAdapter: 0.4 } }`.
+ Times are in milliseconds, start times are relative to the creation of the profiler.
+ */
+- (NSDictionary<NSString *, id> *)report;
+
+@end
+
+NS_ASSUME_NONNULL_END
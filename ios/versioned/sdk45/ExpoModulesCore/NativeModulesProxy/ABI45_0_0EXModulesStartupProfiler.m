@@ -0,0 +1,93 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <os/lock.h>
+#import <os/log.h>
+#import <os/signpost.h>
+#import <time.h>
+
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXModulesStartupProfiler.h>
+
+@interface ABI45_0_0EXModulesStartupProfiler ()
+{
+  os_unfair_lock _lock;
+}
+
+@property (nonatomic, strong) os_log_t log;
+@property (nonatomic) uint64_t creationTime;
+@property (nonatomic, strong) NSMutableArray<NSDictionary<NSString *, id> *> *steps;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSNumber *> *> *modules;
+
+@end
+
+@implementation ABI45_0_0EXModulesStartupProfiler
+
+- (instancetype)init
+{
+  if (self = [super init]) {
+    _lock = OS_UNFAIR_LOCK_INIT;
+    _log = os_log_create("dev.expo.modules", "Startup");
+    _creationTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    _steps = [NSMutableArray array];
+    _modules = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)measureStep:(NSString *)stepName block:(NS_NOESCAPE dispatch_block_t)block
+{
+  os_signpost_id_t signpostId = os_signpost_id_generate(_log);
+  os_signpost_interval_begin(_log, signpostId, "ExpoModulesStartup", "%{public}@", stepName);
+  uint64_t startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+
+  block();
+
+  uint64_t endTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+  os_signpost_interval_end(_log, signpostId, "ExpoModulesStartup", "%{public}@", stepName);
+
+  os_unfair_lock_lock(&_lock);
+  [_steps addObject:@{
+    @"name": stepName,
+    @"startTime": @((double)(startTime - _creationTime) / NSEC_PER_MSEC),
+    @"duration": @((double)(endTime - startTime) / NSEC_PER_MSEC),
+  }];
+  os_unfair_lock_unlock(&_lock);
+}
+
+- (void)measureStep:(NSString *)stepName ofModule:(NSString *)moduleName block:(NS_NOESCAPE dispatch_block_t)block
+{
+  os_signpost_id_t signpostId = os_signpost_id_generate(_log);
+  os_signpost_interval_begin(_log, signpostId, "ExpoModuleStartup", "%{public}@ %{public}@", stepName, moduleName);
+  uint64_t startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+
+  block();
+
+  uint64_t endTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+  os_signpost_interval_end(_log, signpostId, "ExpoModuleStartup", "%{public}@ %{public}@", stepName, moduleName);
+
+  os_unfair_lock_lock(&_lock);
+  NSMutableDictionary<NSString *, NSNumber *> *moduleSteps = _modules[moduleName];
+  if (!moduleSteps) {
+    moduleSteps = [NSMutableDictionary dictionary];
+    _modules[moduleName] = moduleSteps;
+  }
+  // Steps done multiple times for the same module (e.g. for each of its views) are summed up.
+  moduleSteps[stepName] = @([moduleSteps[stepName] doubleValue] + (double)(endTime - startTime) / NSEC_PER_MSEC);
+  os_unfair_lock_unlock(&_lock);
+}
+
+- (NSDictionary<NSString *, id> *)report
+{
+  os_unfair_lock_lock(&_lock);
+  NSMutableDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *modules = [NSMutableDictionary dictionaryWithCapacity:_modules.count];
+  [_modules enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull moduleName, NSMutableDictionary<NSString *, NSNumber *> * _Nonnull moduleSteps, BOOL * _Nonnull stop) {
+    modules[moduleName] = [moduleSteps copy];
+  }];
+  NSDictionary<NSString *, id> *report = @{
+    @"steps": [_steps copy],
+    @"modules": modules,
+  };
+  os_unfair_lock_unlock(&_lock);
+  return report;
+}
+
+@end
@@ -14,6 +14,16 @@
 @class SwiftInteropBridge;
 @class ModulesProvider;
 
+// Protocol of modules whose (expensive part of) initialization is safe to run off the main thread,
+// concurrently with the initialization of other modules.
+@protocol ABI45_0_0EXConcurrentlyInitializedModule <NSObject>
+
+// Called on a background thread once the module has been registered and has received the module registry.
+// Method calls dispatched by the proxy to the module wait until this method returns.
+- (void)initializeConcurrently;
+
+@end
+
 NS_SWIFT_NAME(NativeModulesProxy)
 @interface ABI45_0_0EXNativeModulesProxy : NSObject <ABI45_0_0RCTBridgeModule>
 
@@ -22,9 +32,51 @@ NS_SWIFT_NAME(NativeModulesProxy)
 - (nonnull instancetype)init;
 - (nonnull instancetype)initWithModuleRegistry:(nullable ABI45_0_0EXModuleRegistry *)moduleRegistry;
 
+/**
+ Calls the method of a module through the bridge. When the runtime supports JSI, the same call is also available
+ as `global.ExpoModules.NativeModulesProxy.callMethod(moduleName, methodNameOrKey, arguments)`, which resolves
+ the method and converts its arguments directly from JS values. That function is the intended entry point
+ of the JS side of `NativeModulesProxy` (in the `expo-modules-core` package) whenever it's defined;
+ both return a promise settled with the result of the method.
+ */
 - (void)callMethod:(NSString *)moduleName methodNameOrKey:(id)methodNameOrKey arguments:(NSArray *)arguments resolver:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject;
+- (void)callMethodsBatch:(NSArray<NSArray *> *)calls resolver:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject;
+- (void)getStartupReport:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject;
+// Runs `ABI45_0_0EXNativeModulesProxyBenchmark` with given options and resolves with its report.
+// Rejects unless `EXNativeModulesProxyBenchmarks` is set to `YES` in the Info.plist.
+- (void)runCallMethodBenchmark:(NSDictionary *)options resolver:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject;
+- (void)getExecutorMetrics:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject;
 - (id)callMethodSync:(NSString *)moduleName methodName:(NSString *)methodName arguments:(NSArray *)arguments;
 
 + (ModulesProvider *)getExpoModulesProvider;
 
+/**
+ Returns timings of the steps of registering the modules in the bridge, in total and per module
+ (see `ABI45_0_0EXModulesStartupProfiler`). The steps are also emitted as signposts.
+ */
+- (NSDictionary<NSString *, id> *)startupReport;
+
+/**
+ Whether modules' constants, methods and view managers metadata are exported lazily,
+ enabled by setting `EXNativeModulesProxyLazyModules` to `YES` in the Info.plist.
+ Instead of being computed for all the modules before the first frame, they are then exposed by
+ the `NativeModulesProxy` property of the ExpoModules host object and computed on first access.
+ Constants of modules running on the main queue and of Swift modules are still computed during the main queue setup.
+ Regardless of this setting, `NativeModulesProxy.callMethod` calls methods of modules directly over JSI.
+
+ The JS side of `NativeModulesProxy` (in the `expo-modules-core` package, which is not part of this tree) must check
+ the `lazyModules` constant of the `NativeUnimoduleProxy` bridge module and, when it's `true`, read `modulesConstants`,
+ `exportedMethods` and `viewManagersMetadata` from `global.ExpoModules.NativeModulesProxy` instead of the empty
+ dictionaries exported by the bridge module. Apps must only enable this setting with such a version of the package.
+ */
++ (BOOL)lazyModulesEnabled;
+
+/**
+ Whether method calls of legacy modules run on the shared `ABI45_0_0EXModulesExecutor` instead of the modules' method queues,
+ enabled by setting `EXNativeModulesProxySharedExecutor` to `YES` in the Info.plist. Only modules conforming to `ABI45_0_0EXModulesExecutorClient`
+ use the executor, others keep running on their method queues. Methods of a module still run one by one unless the module allows
+ concurrent calls; modules running on the main queue keep running there.
+ */
++ (BOOL)sharedExecutorEnabled;
+
 @end
@@ -1,8 +1,10 @@
 // Copyright 2018-present 650 Industries. All rights reserved.
 
 #import <objc/runtime.h>
+#import <os/lock.h>
 
 #import <ABI45_0_0React/ABI45_0_0RCTLog.h>
+#import <ABI45_0_0React/ABI45_0_0RCTUtils.h>
 #import <ABI45_0_0React/ABI45_0_0RCTUIManager.h>
 #import <ABI45_0_0React/ABI45_0_0RCTComponentData.h>
 #import <ABI45_0_0React/ABI45_0_0RCTModuleData.h>
@@ -12,21 +14,39 @@
 
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXNativeModulesProxy.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXEventEmitter.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXExportedMethodsTable.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXModulesExecutor.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXModulesStartupProfiler.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXNativeModulesProxyBenchmark.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXViewManager.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXViewManagerAdapter.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXViewManagerAdapterClassesRegistry.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXModuleRegistryProvider.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXReactNativeEventEmitter.h>
 #import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXJSIInstaller.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXJSIConversions.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXNativeModulesProxyJSI.h>
 #import <ABI45_0_0ExpoModulesCore/Swift.h>
 
 static const NSString *exportedMethodsNamesKeyPath = @"exportedMethods";
 static const NSString *viewManagersMetadataKeyPath = @"viewManagersMetadata";
 static const NSString *exportedConstantsKeyPath = @"modulesConstants";
+static const NSString *lazyModulesKeyPath = @"lazyModules";
 
-static const NSString *methodInfoKeyKey = @"key";
-static const NSString *methodInfoNameKey = @"name";
-static const NSString *methodInfoArgumentsCountKey = @"argumentsCount";
+// Info.plist key that opts the app into lazily exported constants and methods.
+static NSString *lazyModulesInfoPlistKey = @"EXNativeModulesProxyLazyModules";
+
+// Info.plist key that opts the app into running method calls on the shared executor.
+static NSString *sharedExecutorInfoPlistKey = @"EXNativeModulesProxySharedExecutor";
+
+// Info.plist key that allows running the benchmarks of method calls from JS.
+static NSString *benchmarksInfoPlistKey = @"EXNativeModulesProxyBenchmarks";
+
+// Name of the ExpoModules global object and of its property exposing the proxy.
+static const char *expoModulesGlobalPropertyName = "ExpoModules";
+static const char *nativeModulesProxyPropertyName = "NativeModulesProxy";
+static const char *callMethodPropertyName = "callMethod";
+static const char *callMethodSyncPropertyName = "callMethodSync";
 
 @interface ABI45_0_0RCTBridge (RegisterAdditionalModuleClasses)
 
@@ -41,17 +61,229 @@ static const NSString *methodInfoArgumentsCountKey = @"argumentsCount";
 
 @end
 
+namespace jsi = ABI45_0_0facebook::jsi;
+
+namespace ABI45_0_0expo {
+
+/**
+ Host object exposing an Objective-C dictionary whose values are computed on demand.
+ Values are converted each time they are read, so the providers are expected to cache them.
+ */
+class LazyDictionaryHostObject : public jsi::HostObject {
+public:
+  using ValueProvider = id _Nullable (^)(NSString * _Nonnull key);
+  using KeysProvider = NSArray<NSString *> * _Nonnull (^)(void);
+
+  LazyDictionaryHostObject(ValueProvider valueProvider, KeysProvider keysProvider)
+    : valueProvider_(valueProvider), keysProvider_(keysProvider) {}
+
+  jsi::Value get(jsi::Runtime &runtime, const jsi::PropNameID &name) override
+  {
+    NSString *key = [NSString stringWithUTF8String:name.utf8(runtime).c_str()];
+    id value = valueProvider_(key);
+    return value != nil ? convertObjCObjectToJSIValue(runtime, value) : jsi::Value::undefined();
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &runtime) override
+  {
+    std::vector<jsi::PropNameID> propertyNames;
+    for (NSString *key in keysProvider_()) {
+      propertyNames.push_back(jsi::PropNameID::forUtf8(runtime, [key UTF8String]));
+    }
+    return propertyNames;
+  }
+
+private:
+  ValueProvider valueProvider_;
+  KeysProvider keysProvider_;
+};
+
+/**
+ Wraps the ExpoModules host object to additionally expose the `NativeModulesProxy` object,
+ which has the same shape as the constants exported by the proxy bridge module.
+ */
+class ExpoModulesWithProxyHostObject : public jsi::HostObject {
+public:
+  ExpoModulesWithProxyHostObject(std::shared_ptr<jsi::HostObject> expoModules, std::shared_ptr<jsi::HostObject> nativeModulesProxy)
+    : expoModules_(std::move(expoModules)), nativeModulesProxy_(std::move(nativeModulesProxy)) {}
+
+  jsi::Value get(jsi::Runtime &runtime, const jsi::PropNameID &name) override
+  {
+    if (name.utf8(runtime) == nativeModulesProxyPropertyName) {
+      return jsi::Object::createFromHostObject(runtime, nativeModulesProxy_);
+    }
+    return expoModules_->get(runtime, name);
+  }
+
+  void set(jsi::Runtime &runtime, const jsi::PropNameID &name, const jsi::Value &value) override
+  {
+    expoModules_->set(runtime, name, value);
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &runtime) override
+  {
+    std::vector<jsi::PropNameID> propertyNames = expoModules_->getPropertyNames(runtime);
+    propertyNames.push_back(jsi::PropNameID::forAscii(runtime, nativeModulesProxyPropertyName));
+    return propertyNames;
+  }
+
+private:
+  std::shared_ptr<jsi::HostObject> expoModules_;
+  std::shared_ptr<jsi::HostObject> nativeModulesProxy_;
+};
+
+/**
+ Host object of `NativeModulesProxy`, with the same keys as the eagerly exported constants
+ (computed lazily) and the `callMethod` and `callMethodSync` functions calling methods of modules directly over JSI.
+ */
+class NativeModulesProxyHostObject : public jsi::HostObject {
+public:
+  NativeModulesProxyHostObject(std::shared_ptr<jsi::HostObject> modulesConstants,
+                               std::shared_ptr<jsi::HostObject> exportedMethods,
+                               std::shared_ptr<jsi::HostObject> viewManagersMetadata,
+                               jsi::HostFunctionType callMethod,
+                               jsi::HostFunctionType callMethodSync)
+    : modulesConstants_(std::move(modulesConstants)),
+      exportedMethods_(std::move(exportedMethods)),
+      viewManagersMetadata_(std::move(viewManagersMetadata)),
+      callMethod_(std::move(callMethod)),
+      callMethodSync_(std::move(callMethodSync)) {}
+
+  jsi::Value get(jsi::Runtime &runtime, const jsi::PropNameID &name) override
+  {
+    std::string propertyName = name.utf8(runtime);
+    if (propertyName == [exportedConstantsKeyPath UTF8String]) {
+      return jsi::Object::createFromHostObject(runtime, modulesConstants_);
+    }
+    if (propertyName == [exportedMethodsNamesKeyPath UTF8String]) {
+      return jsi::Object::createFromHostObject(runtime, exportedMethods_);
+    }
+    if (propertyName == [viewManagersMetadataKeyPath UTF8String]) {
+      return jsi::Object::createFromHostObject(runtime, viewManagersMetadata_);
+    }
+    if (propertyName == callMethodPropertyName) {
+      return jsi::Function::createFromHostFunction(runtime, name, 3, callMethod_);
+    }
+    if (propertyName == callMethodSyncPropertyName) {
+      return jsi::Function::createFromHostFunction(runtime, name, 3, callMethodSync_);
+    }
+    return jsi::Value::undefined();
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &runtime) override
+  {
+    std::vector<jsi::PropNameID> propertyNames;
+    propertyNames.push_back(jsi::PropNameID::forUtf8(runtime, [exportedConstantsKeyPath UTF8String]));
+    propertyNames.push_back(jsi::PropNameID::forUtf8(runtime, [exportedMethodsNamesKeyPath UTF8String]));
+    propertyNames.push_back(jsi::PropNameID::forUtf8(runtime, [viewManagersMetadataKeyPath UTF8String]));
+    propertyNames.push_back(jsi::PropNameID::forAscii(runtime, callMethodPropertyName));
+    propertyNames.push_back(jsi::PropNameID::forAscii(runtime, callMethodSyncPropertyName));
+    return propertyNames;
+  }
+
+private:
+  std::shared_ptr<jsi::HostObject> modulesConstants_;
+  std::shared_ptr<jsi::HostObject> exportedMethods_;
+  std::shared_ptr<jsi::HostObject> viewManagersMetadata_;
+  jsi::HostFunctionType callMethod_;
+  jsi::HostFunctionType callMethodSync_;
+};
+
+} // namespace ABI45_0_0expo
+
+/**
+ Holds the method calls of a module until its concurrent initialization completes. Calls are parked on a serial queue
+ that stays suspended until the gate is opened, and are forwarded from it in the order they were dispatched.
+ Once the gate is open, calls keep going through the queue until it has drained, so none of them can overtake
+ a call dispatched earlier; after that they are forwarded directly.
+ */
+@interface ABI45_0_0EXModuleInitializationGate : NSObject
+
+- (instancetype)initWithModuleName:(NSString *)moduleName;
+
+// Called once the initialization of the module completes.
+- (void)open;
+
+// Forwards the block right away when the gate is open and drained, parks it on the gate queue otherwise.
+- (void)dispatchBlock:(dispatch_block_t)block;
+
+@end
+
+@implementation ABI45_0_0EXModuleInitializationGate {
+  dispatch_queue_t _queue;
+  os_unfair_lock _lock;
+  BOOL _isOpen;
+  NSUInteger _parkedBlocksCount;
+}
+
+- (instancetype)initWithModuleName:(NSString *)moduleName
+{
+  if (self = [super init]) {
+    NSString *label = [NSString stringWithFormat:@"expo.modules.initializationGate.%@", moduleName];
+    _queue = dispatch_queue_create(label.UTF8String, DISPATCH_QUEUE_SERIAL);
+    dispatch_suspend(_queue);
+    _lock = OS_UNFAIR_LOCK_INIT;
+  }
+  return self;
+}
+
+- (void)open
+{
+  os_unfair_lock_lock(&_lock);
+  BOOL wasOpen = _isOpen;
+  _isOpen = YES;
+  os_unfair_lock_unlock(&_lock);
+
+  if (!wasOpen) {
+    dispatch_resume(_queue);
+  }
+}
+
+- (void)dispatchBlock:(dispatch_block_t)block
+{
+  os_unfair_lock_lock(&_lock);
+  BOOL forwardsDirectly = _isOpen && _parkedBlocksCount == 0;
+  if (!forwardsDirectly) {
+    _parkedBlocksCount++;
+  }
+  os_unfair_lock_unlock(&_lock);
+
+  if (forwardsDirectly) {
+    block();
+    return;
+  }
+  dispatch_async(_queue, ^{
+    block();
+    os_unfair_lock_lock(&self->_lock);
+    self->_parkedBlocksCount--;
+    os_unfair_lock_unlock(&self->_lock);
+  });
+}
+
+@end
+
 @interface ABI45_0_0EXNativeModulesProxy ()
 
 @property (nonatomic, strong) NSRegularExpression *regexp;
 @property (nonatomic, strong) ABI45_0_0EXModuleRegistry *exModuleRegistry;
-@property (nonatomic, strong) NSMutableDictionary<const NSString *, NSMutableDictionary<NSString *, NSNumber *> *> *exportedMethodsKeys;
-@property (nonatomic, strong) NSMutableDictionary<const NSString *, NSMutableDictionary<NSNumber *, NSString *> *> *exportedMethodsReverseKeys;
 @property (nonatomic) BOOL ownsModuleRegistry;
+@property (nonatomic, strong) ABI45_0_0EXModulesStartupProfiler *startupProfiler;
+// Gates of modules initialized concurrently, opened when their initialization completes.
+// Set once before the initializations start and never mutated afterwards, so it can be read from any thread.
+@property (atomic, strong) NSMapTable<id, ABI45_0_0EXModuleInitializationGate *> *initializationGates;
+
+// Caches of the lazily exported values. Constants of modules running on the main queue are cached
+// on the main queue, everything else on the JS thread; `lazyModulesConstants` is guarded by the lock.
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *lazyModulesConstants;
+@property (nonatomic, strong) NSDictionary<NSString *, id> *swiftModulesConstants;
+@property (nonatomic, strong) NSDictionary<NSString *, id> *swiftExportedFunctionNames;
+@property (nonatomic, strong) NSDictionary<NSString *, id> *swiftViewManagersMetadata;
 
 @end
 
-@implementation ABI45_0_0EXNativeModulesProxy
+@implementation ABI45_0_0EXNativeModulesProxy {
+  os_unfair_lock _lazyModulesConstantsLock;
+}
 
 @synthesize bridge = _bridge;
 
@@ -66,9 +298,10 @@ ABI45_0_0RCT_EXPORT_MODULE(NativeUnimoduleProxy)
   if (self = [super init]) {
     _exModuleRegistry = moduleRegistry != nil ? moduleRegistry : [[ABI45_0_0EXModuleRegistryProvider new] moduleRegistry];
     _swiftInteropBridge = [[SwiftInteropBridge alloc] initWithModulesProvider:[ABI45_0_0EXNativeModulesProxy getExpoModulesProvider] legacyModuleRegistry:_exModuleRegistry];
-    _exportedMethodsKeys = [NSMutableDictionary dictionary];
-    _exportedMethodsReverseKeys = [NSMutableDictionary dictionary];
     _ownsModuleRegistry = moduleRegistry == nil;
+    _startupProfiler = [ABI45_0_0EXModulesStartupProfiler new];
+    _lazyModulesConstants = [NSMutableDictionary dictionary];
+    _lazyModulesConstantsLock = OS_UNFAIR_LOCK_INIT;
   }
   return self;
 }
@@ -92,33 +325,35 @@ ABI45_0_0RCT_EXPORT_MODULE(NativeUnimoduleProxy)
 {
   // Install ExpoModules host object in the runtime. It's probably not the right place,
   // but it's the earliest moment in bridge's lifecycle when we have access to the runtime.
-  [self installExpoModulesHostObject];
+  BOOL installedHostObject = [self installExpoModulesHostObject];
+
+  NSMutableDictionary <NSString *, id> *constantsAccumulator = [NSMutableDictionary dictionary];
+
+  // When the modules are lazy, JS reads all of this from `ExpoModules.NativeModulesProxy`
+  // and the values are computed when they are first accessed.
+  if (installedHostObject && [ABI45_0_0EXNativeModulesProxy lazyModulesEnabled]) {
+    [self prepareLazyModulesOnMainQueue];
+    constantsAccumulator[viewManagersMetadataKeyPath] = @{};
+    constantsAccumulator[exportedConstantsKeyPath] = @{};
+    constantsAccumulator[exportedMethodsNamesKeyPath] = @{};
+    constantsAccumulator[lazyModulesKeyPath] = @YES;
+    return constantsAccumulator;
+  }
 
   NSMutableDictionary <NSString *, id> *exportedModulesConstants = [NSMutableDictionary dictionary];
   // Grab all the constants exported by modules
   for (ABI45_0_0EXExportedModule *exportedModule in [_exModuleRegistry getAllExportedModules]) {
-    @try {
-      exportedModulesConstants[[[exportedModule class] exportedModuleName]] = [exportedModule constantsToExport] ?: [NSNull null];
-    } @catch (NSException *exception) {
-      continue;
+    id constants = [self constantsOfExportedModule:exportedModule];
+    if (constants != nil) {
+      exportedModulesConstants[[[exportedModule class] exportedModuleName]] = constants;
     }
   }
   [exportedModulesConstants addEntriesFromDictionary:[_swiftInteropBridge exportedModulesConstants]];
 
   // Also add `exportedMethodsNames`
-  NSMutableDictionary<const NSString *, NSMutableArray<NSMutableDictionary<const NSString *, id> *> *> *exportedMethodsNamesAccumulator = [NSMutableDictionary dictionary];
+  NSMutableDictionary<const NSString *, NSArray<NSDictionary<NSString *, id> *> *> *exportedMethodsNamesAccumulator = [NSMutableDictionary dictionary];
   for (ABI45_0_0EXExportedModule *exportedModule in [_exModuleRegistry getAllExportedModules]) {
-    const NSString *exportedModuleName = [[exportedModule class] exportedModuleName];
-    exportedMethodsNamesAccumulator[exportedModuleName] = [NSMutableArray array];
-    [[exportedModule getExportedMethods] enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull exportedName, NSString * _Nonnull selectorName, BOOL * _Nonnull stop) {
-      NSMutableDictionary<const NSString *, id> *methodInfo = [NSMutableDictionary dictionaryWithDictionary:@{
-                                                                                                              methodInfoNameKey: exportedName,
-                                                                                                              // - 3 is for resolver and rejecter of the promise and the last, empty component
-                                                                                                              methodInfoArgumentsCountKey: @([[selectorName componentsSeparatedByString:@":"] count] - 3)
-                                                                                                              }];
-      [exportedMethodsNamesAccumulator[exportedModuleName] addObject:methodInfo];
-    }];
-    [self assignExportedMethodsKeys:exportedMethodsNamesAccumulator[exportedModuleName] forModuleName:exportedModuleName];
+    exportedMethodsNamesAccumulator[[[exportedModule class] exportedModuleName]] = [self exportedMethodsOfExportedModule:exportedModule];
   }
 
   // Add entries from Swift modules
@@ -129,15 +364,12 @@ ABI45_0_0RCT_EXPORT_MODULE(NativeUnimoduleProxy)
   NSMutableDictionary<NSString *, NSDictionary *> *viewManagersMetadata = [[NSMutableDictionary alloc] initWithCapacity:[viewManagers count]];
 
   for (ABI45_0_0EXViewManager *viewManager in viewManagers) {
-    viewManagersMetadata[viewManager.viewName] = @{
-      @"propsNames": [[viewManager getPropsNames] allKeys]
-    };
+    viewManagersMetadata[viewManager.viewName] = [self metadataOfViewManager:viewManager];
   }
 
   // Add entries from Swift view managers
   [viewManagersMetadata addEntriesFromDictionary:[_swiftInteropBridge viewManagersMetadata]];
 
-  NSMutableDictionary <NSString *, id> *constantsAccumulator = [NSMutableDictionary dictionary];
   constantsAccumulator[viewManagersMetadataKeyPath] = viewManagersMetadata;
   constantsAccumulator[exportedConstantsKeyPath] = exportedModulesConstants;
   constantsAccumulator[exportedMethodsNamesKeyPath] = exportedMethodsNamesAccumulator;
@@ -169,38 +401,154 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
     [_swiftInteropBridge callFunction:methodNameOrKey onModule:moduleName withArgs:arguments resolve:resolve reject:reject];
     return;
   }
-  ABI45_0_0EXExportedModule *module = [_exModuleRegistry getExportedModuleForName:moduleName];
+
+  NSString *methodName;
+  ABI45_0_0EXExportedModule *module = [self exportedModuleForCall:moduleName methodNameOrKey:methodNameOrKey methodName:&methodName rejecter:reject];
   if (module == nil) {
-    NSString *reason = [NSString stringWithFormat:@"No exported module was found for name '%@'. Are you sure all the packages are linked correctly?", moduleName];
-    reject(@"E_NO_MODULE", reason, nil);
     return;
   }
 
-  if (!methodNameOrKey) {
-    reject(@"E_NO_METHOD", @"No method key or name provided", nil);
-    return;
-  }
+  [self dispatchCallOfMethod:methodName toModule:module block:^{
+    [self callExportedMethod:methodName ofModule:module arguments:arguments resolver:resolve rejecter:reject];
+  }];
+}
 
-  NSString *methodName;
-  if ([methodNameOrKey isKindOfClass:[NSString class]]) {
-    methodName = (NSString *)methodNameOrKey;
-  } else if ([methodNameOrKey isKindOfClass:[NSNumber class]]) {
-    methodName = _exportedMethodsReverseKeys[moduleName][(NSNumber *)methodNameOrKey];
-  } else {
-    reject(@"E_INV_MKEY", @"Method key is neither a String nor an Integer -- don't know how to map it to method name.", nil);
-    return;
+/**
+ Calls multiple methods in one bridge crossing. Each call is an array of the module name,
+ the method name or key and the arguments, just like the arguments of `callMethod`.
+ Calls to legacy modules are grouped by the modules' method queues and each group runs in a single dispatch,
+ in the order the calls were given. The promise is resolved once all the calls have settled, with an array
+ whose elements are either `{ result }` or `{ error: { code, message } }` objects, in the order of the calls.
+ */
+ABI45_0_0RCT_EXPORT_METHOD(callMethodsBatch:(NSArray<NSArray *> *)calls resolver:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject)
+{
+  NSMutableArray *results = [NSMutableArray arrayWithCapacity:calls.count];
+  for (NSUInteger i = 0; i < calls.count; i++) {
+    [results addObject:[NSNull null]];
   }
 
-  dispatch_async([module methodQueue], ^{
-    @try {
-      [module callExportedMethod:methodName withArguments:arguments resolver:resolve rejecter:reject];
-    } @catch (NSException *e) {
-      NSString *message = [NSString stringWithFormat:@"An exception was thrown while calling `%@.%@` with arguments `%@`: %@", moduleName, methodName, arguments, e];
-      reject(@"E_EXC", message, nil);
+  dispatch_group_t group = dispatch_group_create();
+  // Calls that run on the same method queue, or on the shared executor with the same priority and serial key,
+  // are dispatched together in a single block, keyed by a description of where they run.
+  NSMutableDictionary<NSString *, NSMutableArray<dispatch_block_t> *> *callsByTarget = [NSMutableDictionary dictionary];
+  NSMutableArray<NSString *> *targets = [NSMutableArray array];
+  NSMutableDictionary<NSString *, void (^)(dispatch_block_t)> *dispatchersByTarget = [NSMutableDictionary dictionary];
+
+  for (NSUInteger i = 0; i < calls.count; i++) {
+    // Each call settles exactly once, even if its module calls both the resolver and the rejecter.
+    __block BOOL settled = NO;
+    void (^settle)(NSDictionary *) = ^(NSDictionary *result) {
+      @synchronized (results) {
+        if (settled) {
+          return;
+        }
+        settled = YES;
+        results[i] = result;
+      }
+      dispatch_group_leave(group);
+    };
+    ABI45_0_0RCTPromiseResolveBlock callResolve = ^(id result) {
+      settle(@{ @"result": result ?: [NSNull null] });
+    };
+    ABI45_0_0RCTPromiseRejectBlock callReject = ^(NSString *code, NSString *message, NSError *error) {
+      settle(@{ @"error": @{ @"code": code ?: @"E_UNKNOWN", @"message": message ?: @"" } });
+    };
+    dispatch_group_enter(group);
+
+    NSArray *call = calls[i];
+    if (![call isKindOfClass:[NSArray class]] || call.count != 3 || ![call[0] isKindOfClass:[NSString class]] || ![call[2] isKindOfClass:[NSArray class]]) {
+      callReject(@"E_INV_CALL", @"Each call of the batch must be an array of a module name, a method key or name and an array of arguments.", nil);
+      continue;
     }
+
+    NSString *moduleName = call[0];
+    id methodNameOrKey = call[1];
+    NSArray *arguments = call[2];
+
+    if ([_swiftInteropBridge hasModule:moduleName]) {
+      [_swiftInteropBridge callFunction:methodNameOrKey onModule:moduleName withArgs:arguments resolve:callResolve reject:callReject];
+      continue;
+    }
+
+    NSString *methodName;
+    ABI45_0_0EXExportedModule *module = [self exportedModuleForCall:moduleName methodNameOrKey:methodNameOrKey methodName:&methodName rejecter:callReject];
+    if (module == nil) {
+      continue;
+    }
+
+    dispatch_block_t methodCall = ^{
+      [self callExportedMethod:methodName ofModule:module arguments:arguments resolver:callResolve rejecter:callReject];
+    };
+
+    ABI45_0_0EXModulesExecutorPriority priority = ABI45_0_0EXModulesExecutorPriorityUserInteractive;
+    NSString *serialKey = nil;
+    dispatch_queue_t methodQueue = [self methodQueueOfMethod:methodName ofModule:module priority:&priority serialKey:&serialKey];
+    if (!methodQueue && !serialKey) {
+      // Calls that may run concurrently are not grouped.
+      [self dispatchBlock:methodCall toModule:module methodQueue:nil priority:priority serialKey:nil];
+      continue;
+    }
+
+    // Calls of modules initialized concurrently are grouped per module, as they wait for its initialization.
+    id initializedModule = [self.initializationGates objectForKey:module] ? module : nil;
+    NSString *target = [NSString stringWithFormat:@"%p:%p:%ld:%@", initializedModule, methodQueue, (long)priority, serialKey];
+    NSMutableArray<dispatch_block_t> *targetCalls = [callsByTarget objectForKey:target];
+    if (!targetCalls) {
+      targetCalls = [NSMutableArray array];
+      [callsByTarget setObject:targetCalls forKey:target];
+      [targets addObject:target];
+      [dispatchersByTarget setObject:^(dispatch_block_t block) {
+        [self dispatchBlock:block toModule:module methodQueue:methodQueue priority:priority serialKey:serialKey];
+      } forKey:target];
+    }
+    [targetCalls addObject:methodCall];
+  }
+
+  for (NSString *target in targets) {
+    NSArray<dispatch_block_t> *targetCalls = [callsByTarget objectForKey:target];
+    [dispatchersByTarget objectForKey:target](^{
+      for (dispatch_block_t targetCall in targetCalls) {
+        targetCall();
+      }
+    });
+  }
+
+  dispatch_group_notify(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+    resolve(results);
   });
 }
 
+ABI45_0_0RCT_EXPORT_METHOD(getStartupReport:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject)
+{
+  resolve([self startupReport]);
+}
+
+- (NSDictionary<NSString *, id> *)startupReport
+{
+  return [_startupProfiler report];
+}
+
+ABI45_0_0RCT_EXPORT_METHOD(runCallMethodBenchmark:(NSDictionary *)options resolver:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject)
+{
+  if (![[NSBundle.mainBundle objectForInfoDictionaryKey:benchmarksInfoPlistKey] boolValue]) {
+    reject(@"E_BENCHMARKS_DISABLED", [NSString stringWithFormat:@"Benchmarks are disabled, set `%@` to `YES` in the Info.plist to enable them.", benchmarksInfoPlistKey], nil);
+    return;
+  }
+  if (![options[@"moduleName"] isKindOfClass:[NSString class]] || ![options[@"methodName"] isKindOfClass:[NSString class]]) {
+    reject(@"E_INVALID_BENCHMARK", @"Benchmark options must contain `moduleName` and `methodName` strings.", nil);
+    return;
+  }
+  ABI45_0_0EXNativeModulesProxyBenchmark *benchmark = [[ABI45_0_0EXNativeModulesProxyBenchmark alloc] initWithProxy:self];
+  [benchmark runWithOptions:options completion:^(NSDictionary<NSString *, id> *report) {
+    resolve(report);
+  }];
+}
+
+ABI45_0_0RCT_EXPORT_METHOD(getExecutorMetrics:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject)
+{
+  resolve([ABI45_0_0EXNativeModulesProxy sharedExecutorEnabled] ? [[ABI45_0_0EXModulesExecutor sharedExecutor] metrics] : [NSNull null]);
+}
+
 - (id)callMethodSync:(NSString *)moduleName methodName:(NSString *)methodName arguments:(NSArray *)arguments
 {
   if ([_swiftInteropBridge hasModule:moduleName]) {
@@ -211,6 +559,26 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
 
 #pragma mark - Statics
 
++ (BOOL)lazyModulesEnabled
+{
+  static BOOL lazyModulesEnabled;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    lazyModulesEnabled = [[NSBundle.mainBundle objectForInfoDictionaryKey:lazyModulesInfoPlistKey] boolValue];
+  });
+  return lazyModulesEnabled;
+}
+
++ (BOOL)sharedExecutorEnabled
+{
+  static BOOL sharedExecutorEnabled;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedExecutorEnabled = [[NSBundle.mainBundle objectForInfoDictionaryKey:sharedExecutorInfoPlistKey] boolValue];
+  });
+  return sharedExecutorEnabled;
+}
+
 + (ModulesProvider *)getExpoModulesProvider
 {
   // Dynamically gets the modules provider class.
@@ -240,24 +608,40 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
 #pragma mark - Privates
 
 - (void)registerExpoModulesInBridge:(ABI45_0_0RCTBridge *)bridge
+{
+  [_startupProfiler measureStep:@"registerExpoModules" block:^{
+    [self registerExpoModulesInBridgeMeasured:bridge];
+  }];
+
+  // Modules that are safe to be initialized off the main thread are initialized concurrently,
+  // once all the modules have been registered and have consumed the registry.
+  [self initializeModulesConcurrently];
+}
+
+- (void)registerExpoModulesInBridgeMeasured:(ABI45_0_0RCTBridge *)bridge
 {
   // Registering expo modules (excluding Swifty view managers!) in bridge is needed only when the proxy module owns
   // the registry (was autoinitialized by ABI45_0_0React Native). Otherwise they're registered by the registry adapter.
   BOOL ownsModuleRegistry = _ownsModuleRegistry && ![bridge moduleIsInitialized:[ABI45_0_0EXReactNativeEventEmitter class]];
+  ABI45_0_0EXModulesStartupProfiler *profiler = _startupProfiler;
 
   // An array of `ABI45_0_0RCTBridgeModule` classes to register.
   NSMutableArray<Class<ABI45_0_0RCTBridgeModule>> *additionalModuleClasses = [NSMutableArray new];
   NSMutableSet *visitedSweetModules = [NSMutableSet new];
 
   // Add dynamic wrappers for view modules written in Sweet API.
-  for (ViewModuleWrapper *swiftViewModule in [_swiftInteropBridge getViewManagers]) {
-    Class wrappedViewModuleClass = [self registerComponentData:swiftViewModule inBridge:bridge];
-    [additionalModuleClasses addObject:wrappedViewModuleClass];
-    [visitedSweetModules addObject:swiftViewModule.name];
-  }
+  [profiler measureStep:@"registerSwiftViewModules" block:^{
+    for (ViewModuleWrapper *swiftViewModule in [self.swiftInteropBridge getViewManagers]) {
+      [profiler measureStep:@"registerComponentData" ofModule:swiftViewModule.name block:^{
+        Class wrappedViewModuleClass = [self registerComponentData:swiftViewModule inBridge:bridge];
+        [additionalModuleClasses addObject:wrappedViewModuleClass];
+      }];
+      [visitedSweetModules addObject:swiftViewModule.name];
+    }
 
-  [additionalModuleClasses addObject:[ViewModuleWrapper class]];
-  [self registerLegacyComponentData:[ViewModuleWrapper class] inBridge:bridge];
+    [additionalModuleClasses addObject:[ViewModuleWrapper class]];
+    [self registerLegacyComponentData:[ViewModuleWrapper class] inBridge:bridge];
+  }];
 
   // Add modules from legacy module registry only when the NativeModulesProxy owns the registry.
   if (ownsModuleRegistry) {
@@ -266,13 +650,20 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
     [additionalModuleClasses addObject:[ABI45_0_0EXReactNativeEventEmitter class]];
 
     // Add dynamic wrappers for the classic view managers.
-    for (ABI45_0_0EXViewManager *viewManager in [_exModuleRegistry getAllViewManagers]) {
-      if (![visitedSweetModules containsObject:viewManager.viewName]) {
-        Class viewManagerWrapperClass = [ABI45_0_0EXViewManagerAdapterClassesRegistry createViewManagerAdapterClassForViewManager:viewManager];
-        [additionalModuleClasses addObject:viewManagerWrapperClass];
-        [self registerLegacyComponentData:viewManagerWrapperClass inBridge:bridge];
+    [profiler measureStep:@"registerLegacyViewManagers" block:^{
+      for (ABI45_0_0EXViewManager *viewManager in [self.exModuleRegistry getAllViewManagers]) {
+        if (![visitedSweetModules containsObject:viewManager.viewName]) {
+          __block Class viewManagerWrapperClass;
+          [profiler measureStep:@"createViewManagerAdapter" ofModule:viewManager.viewName block:^{
+            viewManagerWrapperClass = [ABI45_0_0EXViewManagerAdapterClassesRegistry createViewManagerAdapterClassForViewManager:viewManager];
+          }];
+          [additionalModuleClasses addObject:viewManagerWrapperClass];
+          [profiler measureStep:@"registerComponentData" ofModule:viewManager.viewName block:^{
+            [self registerLegacyComponentData:viewManagerWrapperClass inBridge:bridge];
+          }];
+        }
       }
-    }
+    }];
 
     // View manager wrappers don't have their own prop configs, so we must register
     // their base view managers that provides common props such as `proxiedProperties`.
@@ -280,20 +671,28 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
     [additionalModuleClasses addObject:[ABI45_0_0EXViewManagerAdapter class]];
 
     // Some modules might need access to the bridge.
-    for (id module in [_exModuleRegistry getAllInternalModules]) {
-      if ([module conformsToProtocol:@protocol(ABI45_0_0RCTBridgeModule)]) {
-        [module setValue:bridge forKey:@"bridge"];
+    [profiler measureStep:@"setBridgeOnInternalModules" block:^{
+      for (id module in [self.exModuleRegistry getAllInternalModules]) {
+        if ([module conformsToProtocol:@protocol(ABI45_0_0RCTBridgeModule)]) {
+          [profiler measureStep:@"setBridge" ofModule:NSStringFromClass([module class]) block:^{
+            [module setValue:bridge forKey:@"bridge"];
+          }];
+        }
       }
-    }
+    }];
   }
 
   // `registerAdditionalModuleClasses:` call below is not thread-safe if ABI45_0_0RCTUIManager is not initialized.
   // The case happens especially with reanimated which accesses `bridge.uiManager` and initialize bridge in js thread.
   // Accessing uiManager here, we try to make sure ABI45_0_0RCTUIManager is initialized.
-  [bridge uiManager];
+  [profiler measureStep:@"initializeUIManager" block:^{
+    [bridge uiManager];
+  }];
 
   // Register the view managers as additional modules.
-  [self registerAdditionalModuleClasses:additionalModuleClasses inBridge:bridge];
+  [profiler measureStep:@"registerAdditionalModuleClasses" block:^{
+    [self registerAdditionalModuleClasses:additionalModuleClasses inBridge:bridge];
+  }];
 
   // Get the instance of `ABI45_0_0EXReactEventEmitter` bridge module and give it access to the interop bridge.
   ABI45_0_0EXReactNativeEventEmitter *eventEmitter = [bridge moduleForClass:[ABI45_0_0EXReactNativeEventEmitter class]];
@@ -306,7 +705,47 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
 
     // Let the modules consume the registry :)
     // It calls `setModuleRegistry:` on all `ABI45_0_0EXModuleRegistryConsumer`s.
-    [_exModuleRegistry initialize];
+    [profiler measureStep:@"initializeModuleRegistry" block:^{
+      [self.exModuleRegistry initialize];
+    }];
+  }
+}
+
+/**
+ Calls `initializeConcurrently` of all the modules conforming to `ABI45_0_0EXConcurrentlyInitializedModule`
+ on background threads, in parallel with each other and with the rest of the app startup.
+ */
+- (void)initializeModulesConcurrently
+{
+  NSHashTable *modules = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+  for (id module in [_exModuleRegistry getAllInternalModules]) {
+    [modules addObject:module];
+  }
+  for (id module in [_exModuleRegistry getAllExportedModules]) {
+    [modules addObject:module];
+  }
+
+  ABI45_0_0EXModulesStartupProfiler *profiler = _startupProfiler;
+  dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+  NSMapTable<id, ABI45_0_0EXModuleInitializationGate *> *gates = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                                                     valueOptions:NSPointerFunctionsStrongMemory];
+
+  for (id module in modules) {
+    if ([module conformsToProtocol:@protocol(ABI45_0_0EXConcurrentlyInitializedModule)]) {
+      NSString *moduleName = NSStringFromClass([module class]);
+      [gates setObject:[[ABI45_0_0EXModuleInitializationGate alloc] initWithModuleName:moduleName] forKey:module];
+    }
+  }
+  self.initializationGates = gates;
+
+  for (id module in gates) {
+    ABI45_0_0EXModuleInitializationGate *gate = [gates objectForKey:module];
+    dispatch_async(queue, ^{
+      [profiler measureStep:@"initializeConcurrently" ofModule:NSStringFromClass([module class]) block:^{
+        [(id<ABI45_0_0EXConcurrentlyInitializedModule>)module initializeConcurrently];
+      }];
+      [gate open];
+    });
   }
 }
 
@@ -371,41 +810,150 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
   }
 }
 
-- (void)assignExportedMethodsKeys:(NSMutableArray<NSMutableDictionary<const NSString *, id> *> *)exportedMethods forModuleName:(const NSString *)moduleName
+/**
+ Returns the legacy module that the call should be forwarded to and sets the name of the method to call.
+ Rejects and returns `nil` if the module or the method cannot be found.
+ */
+- (nullable ABI45_0_0EXExportedModule *)exportedModuleForCall:(NSString *)moduleName
+                                     methodNameOrKey:(id)methodNameOrKey
+                                          methodName:(NSString * _Nullable * _Nonnull)methodName
+                                            rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject
 {
-  if (!_exportedMethodsKeys[moduleName]) {
-    _exportedMethodsKeys[moduleName] = [NSMutableDictionary dictionary];
+  ABI45_0_0EXExportedModule *module = [_exModuleRegistry getExportedModuleForName:moduleName];
+  if (module == nil) {
+    NSString *reason = [NSString stringWithFormat:@"No exported module was found for name '%@'. Are you sure all the packages are linked correctly?", moduleName];
+    reject(@"E_NO_MODULE", reason, nil);
+    return nil;
   }
 
-  if (!_exportedMethodsReverseKeys[moduleName]) {
-    _exportedMethodsReverseKeys[moduleName] = [NSMutableDictionary dictionary];
+  if (!methodNameOrKey) {
+    reject(@"E_NO_METHOD", @"No method key or name provided", nil);
+    return nil;
   }
 
-  for (int i = 0; i < [exportedMethods count]; i++) {
-    NSMutableDictionary<const NSString *, id> *methodInfo = exportedMethods[i];
+  if ([methodNameOrKey isKindOfClass:[NSString class]]) {
+    *methodName = (NSString *)methodNameOrKey;
+  } else if ([methodNameOrKey isKindOfClass:[NSNumber class]]) {
+    *methodName = [[ABI45_0_0EXExportedMethodsTable tableForExportedModule:module] methodNameForKey:(NSNumber *)methodNameOrKey];
+  } else {
+    reject(@"E_INV_MKEY", @"Method key is neither a String nor an Integer -- don't know how to map it to method name.", nil);
+    return nil;
+  }
+  return module;
+}
 
-    if (!methodInfo[(NSString *)methodInfoNameKey] || ![methodInfo[methodInfoNameKey] isKindOfClass:[NSString class]]) {
-      NSString *reason = [NSString stringWithFormat:@"Method info of a method of module %@ has no method name.", moduleName];
-      @throw [NSException exceptionWithName:@"Empty method name in method info" reason:reason userInfo:nil];
-    }
+/**
+ Returns the method queue on which calls of the method of the legacy module run, or `nil` if they run on the shared executor,
+ in which case `priority` and `serialKey` are set to the priority and serial key of the call.
+ The shared executor is used only when enabled and only by modules conforming to `ABI45_0_0EXModulesExecutorClient`,
+ except for those whose method queue is the main queue. Other modules keep running on their own method queues.
+ */
+- (nullable dispatch_queue_t)methodQueueOfMethod:(NSString *)methodName
+                                         ofModule:(ABI45_0_0EXExportedModule *)module
+                                         priority:(ABI45_0_0EXModulesExecutorPriority *)priority
+                                        serialKey:(NSString * _Nullable * _Nonnull)serialKey
+{
+  dispatch_queue_t methodQueue = [module methodQueue];
+  if (![ABI45_0_0EXNativeModulesProxy sharedExecutorEnabled]
+      || methodQueue == dispatch_get_main_queue()
+      || ![module conformsToProtocol:@protocol(ABI45_0_0EXModulesExecutorClient)]) {
+    return methodQueue;
+  }
+
+  id<ABI45_0_0EXModulesExecutorClient> client = (id<ABI45_0_0EXModulesExecutorClient>)module;
+  *priority = [client respondsToSelector:@selector(priorityOfMethod:)]
+    ? [client priorityOfMethod:methodName]
+    : ABI45_0_0EXModulesExecutorPriorityUserInteractive;
+  *serialKey = [client respondsToSelector:@selector(allowsConcurrentMethodCalls)] && [client allowsConcurrentMethodCalls]
+    ? nil
+    : (NSString *)[[module class] exportedModuleName];
+  return nil;
+}
+
+/**
+ Dispatches the block calling the method of the legacy module as determined by `methodQueueOfMethod:ofModule:priority:serialKey:`.
+ */
+- (void)dispatchCallOfMethod:(NSString *)methodName toModule:(ABI45_0_0EXExportedModule *)module block:(dispatch_block_t)block
+{
+  ABI45_0_0EXModulesExecutorPriority priority = ABI45_0_0EXModulesExecutorPriorityUserInteractive;
+  NSString *serialKey = nil;
+  dispatch_queue_t methodQueue = [self methodQueueOfMethod:methodName ofModule:module priority:&priority serialKey:&serialKey];
+  [self dispatchBlock:block toModule:module methodQueue:methodQueue priority:priority serialKey:serialKey];
+}
 
-    NSString *methodName = methodInfo[(NSString *)methodInfoNameKey];
-    NSNumber *previousMethodKey = _exportedMethodsKeys[moduleName][methodName];
-    if (previousMethodKey) {
-      methodInfo[methodInfoKeyKey] = previousMethodKey;
+/**
+ Dispatches the block to the method queue or, when it's `nil`, to the shared executor. If the module is initialized
+ concurrently, the block goes through the module's initialization gate, which holds it until the initialization
+ completes and keeps the order of the blocks dispatched to the module.
+ */
+- (void)dispatchBlock:(dispatch_block_t)block
+             toModule:(ABI45_0_0EXExportedModule *)module
+          methodQueue:(nullable dispatch_queue_t)methodQueue
+             priority:(ABI45_0_0EXModulesExecutorPriority)priority
+            serialKey:(nullable NSString *)serialKey
+{
+  dispatch_block_t dispatchBlock = ^{
+    if (methodQueue) {
+      dispatch_async(methodQueue, block);
     } else {
-      NSNumber *newKey = @([[_exportedMethodsKeys[moduleName] allValues] count]);
-      methodInfo[methodInfoKeyKey] = newKey;
-      _exportedMethodsKeys[moduleName][methodName] = newKey;
-      _exportedMethodsReverseKeys[moduleName][newKey] = methodName;
+      [[ABI45_0_0EXModulesExecutor sharedExecutor] executeBlock:block priority:priority serialKey:serialKey];
     }
+  };
+
+  ABI45_0_0EXModuleInitializationGate *gate = [self.initializationGates objectForKey:module];
+  if (gate) {
+    [gate dispatchBlock:dispatchBlock];
+  } else {
+    dispatchBlock();
+  }
+}
+
+/**
+ Calls the exported method of the legacy module, rejecting if it throws. Must be called as dispatched by `dispatchCallOfMethod:toModule:block:`.
+ */
+- (void)callExportedMethod:(NSString *)methodName ofModule:(ABI45_0_0EXExportedModule *)module arguments:(NSArray *)arguments resolver:(ABI45_0_0RCTPromiseResolveBlock)resolve rejecter:(ABI45_0_0RCTPromiseRejectBlock)reject
+{
+  @try {
+    [module callExportedMethod:methodName withArguments:arguments resolver:resolve rejecter:reject];
+  } @catch (NSException *e) {
+    NSString *message = [NSString stringWithFormat:@"An exception was thrown while calling `%@.%@` with arguments `%@`: %@", [[module class] exportedModuleName], methodName, arguments, e];
+    reject(@"E_EXC", message, nil);
   }
 }
 
+/**
+ Returns constants of the legacy exported module, or `NSNull` if it has none.
+ Returns `nil` if computing them has thrown.
+ */
+- (nullable id)constantsOfExportedModule:(ABI45_0_0EXExportedModule *)exportedModule
+{
+  @try {
+    return [exportedModule constantsToExport] ?: [NSNull null];
+  } @catch (NSException *exception) {
+    return nil;
+  }
+}
+
+/**
+ Returns infos of methods exported by the legacy module, including their keys.
+ */
+- (NSArray<NSDictionary<NSString *, id> *> *)exportedMethodsOfExportedModule:(ABI45_0_0EXExportedModule *)exportedModule
+{
+  return [ABI45_0_0EXExportedMethodsTable tableForExportedModule:exportedModule].methodsInfo;
+}
+
+- (NSDictionary *)metadataOfViewManager:(ABI45_0_0EXViewManager *)viewManager
+{
+  return @{
+    @"propsNames": [[viewManager getPropsNames] allKeys]
+  };
+}
+
 /**
  Installs ExpoModules host object in the runtime that the current bridge operates on.
+ Returns `NO` if there is no JSI runtime, e.g. when remote debugging.
  */
-- (void)installExpoModulesHostObject
+- (BOOL)installExpoModulesHostObject
 {
   ABI45_0_0facebook::jsi::Runtime *jsiRuntime = [_bridge respondsToSelector:@selector(runtime)] ? reinterpret_cast<ABI45_0_0facebook::jsi::Runtime *>(_bridge.runtime) : nullptr;
 
@@ -414,7 +962,284 @@ ABI45_0_0RCT_EXPORT_METHOD(callMethod:(NSString *)moduleName methodNameOrKey:(id
 
     [ABI45_0_0EXJavaScriptRuntimeManager installExpoModulesToRuntime:runtime withSwiftInterop:_swiftInteropBridge];
     [_swiftInteropBridge setRuntime:runtime];
+
+    [self installNativeModulesProxyInRuntime:*jsiRuntime];
+    return YES;
+  }
+  return NO;
+}
+
+#pragma mark - Lazy modules
+
+/**
+ Placeholder cached for modules without constants (or whose constants have thrown), so they are looked up once.
+ */
+static id missingLazyConstants(void)
+{
+  static NSObject *missingLazyConstants;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    missingLazyConstants = [NSObject new];
+  });
+  return missingLazyConstants;
+}
+
+/**
+ Computes the constants which must not be computed on the JS thread: those of legacy modules running on the main queue,
+ which may use UIKit, and those of Swift modules, which the interop bridge only exports all at once on the main queue.
+ Called from `constantsToExport` during the main queue setup, so they are in place before JS runs
+ and the JS thread never has to wait for the main queue, which may itself be waiting for the JS thread.
+ */
+- (void)prepareLazyModulesOnMainQueue
+{
+  _swiftModulesConstants = [_swiftInteropBridge exportedModulesConstants];
+
+  for (ABI45_0_0EXExportedModule *exportedModule in [_exModuleRegistry getAllExportedModules]) {
+    if ([exportedModule methodQueue] == dispatch_get_main_queue()) {
+      [self cacheLazyConstants:[self constantsOfExportedModule:exportedModule] ofModule:(NSString *)[[exportedModule class] exportedModuleName]];
+    }
+  }
+}
+
+- (void)cacheLazyConstants:(nullable id)constants ofModule:(NSString *)moduleName
+{
+  os_unfair_lock_lock(&_lazyModulesConstantsLock);
+  _lazyModulesConstants[moduleName] = constants ?: missingLazyConstants();
+  os_unfair_lock_unlock(&_lazyModulesConstantsLock);
+}
+
+/**
+ Returns constants of the module with given name, computing them on the first access.
+ Constants of modules running on the main queue and of Swift modules have been computed
+ by `prepareLazyModulesOnMainQueue`, the others are computed on the calling (JS) thread.
+ */
+- (nullable id)lazyConstantsOfModule:(NSString *)moduleName
+{
+  if ([_swiftInteropBridge hasModule:moduleName]) {
+    return _swiftModulesConstants[moduleName];
+  }
+
+  os_unfair_lock_lock(&_lazyModulesConstantsLock);
+  id cachedConstants = _lazyModulesConstants[moduleName];
+  os_unfair_lock_unlock(&_lazyModulesConstantsLock);
+  if (cachedConstants) {
+    return cachedConstants != missingLazyConstants() ? cachedConstants : nil;
   }
+
+  ABI45_0_0EXExportedModule *exportedModule = [_exModuleRegistry getExportedModuleForName:moduleName];
+  id constants = exportedModule != nil ? [self constantsOfExportedModule:exportedModule] : nil;
+  [self cacheLazyConstants:constants ofModule:moduleName];
+  return constants;
+}
+
+- (nullable id)lazyExportedMethodsOfModule:(NSString *)moduleName
+{
+  if ([_swiftInteropBridge hasModule:moduleName]) {
+    if (!_swiftExportedFunctionNames) {
+      _swiftExportedFunctionNames = [_swiftInteropBridge exportedFunctionNames];
+    }
+    return _swiftExportedFunctionNames[moduleName];
+  }
+
+  ABI45_0_0EXExportedModule *exportedModule = [_exModuleRegistry getExportedModuleForName:moduleName];
+  return exportedModule != nil ? [self exportedMethodsOfExportedModule:exportedModule] : nil;
+}
+
+- (nullable id)lazyMetadataOfViewManager:(NSString *)viewName
+{
+  for (ABI45_0_0EXViewManager *viewManager in [_exModuleRegistry getAllViewManagers]) {
+    if ([viewManager.viewName isEqualToString:viewName]) {
+      return [self metadataOfViewManager:viewManager];
+    }
+  }
+  if (!_swiftViewManagersMetadata) {
+    _swiftViewManagersMetadata = [_swiftInteropBridge viewManagersMetadata];
+  }
+  return _swiftViewManagersMetadata[viewName];
+}
+
+/**
+ Returns names of all the modules without computing any of their constants
+ (those of Swift modules have already been computed on the main queue).
+ */
+- (NSArray<NSString *> *)lazyModulesNames
+{
+  NSMutableArray<NSString *> *modulesNames = [NSMutableArray array];
+  for (ABI45_0_0EXExportedModule *exportedModule in [_exModuleRegistry getAllExportedModules]) {
+    [modulesNames addObject:(NSString *)[[exportedModule class] exportedModuleName]];
+  }
+  [modulesNames addObjectsFromArray:[_swiftModulesConstants allKeys]];
+  return modulesNames;
+}
+
+- (NSArray<NSString *> *)lazyViewManagersNames
+{
+  NSMutableArray<NSString *> *viewNames = [NSMutableArray array];
+  for (ABI45_0_0EXViewManager *viewManager in [_exModuleRegistry getAllViewManagers]) {
+    [viewNames addObject:viewManager.viewName];
+  }
+  if (!_swiftViewManagersMetadata) {
+    _swiftViewManagersMetadata = [_swiftInteropBridge viewManagersMetadata];
+  }
+  [viewNames addObjectsFromArray:[_swiftViewManagersMetadata allKeys]];
+  return viewNames;
+}
+
+/**
+ Replaces the ExpoModules host object with one that also exposes `NativeModulesProxy`.
+ */
+- (void)installNativeModulesProxyInRuntime:(jsi::Runtime &)runtime
+{
+  jsi::Value expoModules = runtime.global().getProperty(runtime, expoModulesGlobalPropertyName);
+  if (!expoModules.isObject() || !expoModules.getObject(runtime).isHostObject(runtime)) {
+    return;
+  }
+
+  __weak ABI45_0_0EXNativeModulesProxy *weakSelf = self;
+  auto modulesConstants = std::make_shared<ABI45_0_0expo::LazyDictionaryHostObject>(^id(NSString *moduleName) {
+    return [weakSelf lazyConstantsOfModule:moduleName];
+  }, ^NSArray<NSString *> *{
+    return [weakSelf lazyModulesNames] ?: @[];
+  });
+  auto exportedMethods = std::make_shared<ABI45_0_0expo::LazyDictionaryHostObject>(^id(NSString *moduleName) {
+    return [weakSelf lazyExportedMethodsOfModule:moduleName];
+  }, ^NSArray<NSString *> *{
+    return [weakSelf lazyModulesNames] ?: @[];
+  });
+  auto viewManagersMetadata = std::make_shared<ABI45_0_0expo::LazyDictionaryHostObject>(^id(NSString *viewName) {
+    return [weakSelf lazyMetadataOfViewManager:viewName];
+  }, ^NSArray<NSString *> *{
+    return [weakSelf lazyViewManagersNames] ?: @[];
+  });
+  jsi::HostFunctionType callMethod = [weakSelf](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *args, size_t count) -> jsi::Value {
+    ABI45_0_0EXNativeModulesProxy *proxy = weakSelf;
+    if (!proxy) {
+      throw jsi::JSError(runtime, "NativeModulesProxy has been deallocated");
+    }
+    return [proxy callMethodInRuntime:runtime arguments:args count:count];
+  };
+  jsi::HostFunctionType callMethodSync = [weakSelf](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *args, size_t count) -> jsi::Value {
+    ABI45_0_0EXNativeModulesProxy *proxy = weakSelf;
+    if (!proxy) {
+      throw jsi::JSError(runtime, "NativeModulesProxy has been deallocated");
+    }
+    return [proxy callMethodSyncInRuntime:runtime arguments:args count:count];
+  };
+  auto nativeModulesProxy = std::make_shared<ABI45_0_0expo::NativeModulesProxyHostObject>(modulesConstants, exportedMethods, viewManagersMetadata, callMethod, callMethodSync);
+  auto expoModulesWithProxy = std::make_shared<ABI45_0_0expo::ExpoModulesWithProxyHostObject>(expoModules.getObject(runtime).getHostObject(runtime), nativeModulesProxy);
+
+  runtime.global().setProperty(runtime, expoModulesGlobalPropertyName, jsi::Object::createFromHostObject(runtime, expoModulesWithProxy));
+}
+
+#pragma mark - JSI calls
+
+/**
+ Implements `ExpoModules.NativeModulesProxy.callMethod(moduleName, methodNameOrKey, arguments)`, the JSI counterpart
+ of the `callMethod` bridge method. The method is resolved from the table built once for the module class and its
+ invocation is set up directly from JS values, so the call doesn't go through the bridge and its message queue.
+ Returns a promise settled with the result.
+ */
+- (jsi::Value)callMethodInRuntime:(jsi::Runtime &)runtime arguments:(const jsi::Value *)args count:(size_t)count
+{
+  if (count != 3 || !args[0].isString() || !args[2].isObject() || !args[2].getObject(runtime).isArray(runtime)) {
+    throw jsi::JSError(runtime, "callMethod expects a module name, a method key or name and an array of arguments");
+  }
+
+  NSString *moduleName = [NSString stringWithUTF8String:args[0].getString(runtime).utf8(runtime).c_str()];
+  const jsi::Value &methodNameOrKey = args[1];
+  jsi::Array arguments = args[2].getObject(runtime).getArray(runtime);
+  size_t argumentsCount = arguments.size(runtime);
+  std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker = _bridge.jsCallInvoker;
+
+  return ABI45_0_0expo::createPromise(runtime, callInvoker, [&](ABI45_0_0RCTPromiseResolveBlock resolve, ABI45_0_0RCTPromiseRejectBlock reject) {
+    if ([_swiftInteropBridge hasModule:moduleName]) {
+      NSMutableArray *swiftArguments = [NSMutableArray arrayWithCapacity:argumentsCount];
+      for (size_t i = 0; i < argumentsCount; i++) {
+        [swiftArguments addObject:ABI45_0_0expo::convertCallArgument(runtime, arguments.getValueAtIndex(runtime, i), callInvoker) ?: [NSNull null]];
+      }
+      id methodName = methodNameOrKey.isString()
+        ? [NSString stringWithUTF8String:methodNameOrKey.getString(runtime).utf8(runtime).c_str()]
+        : (id)@(methodNameOrKey.isNumber() ? methodNameOrKey.getNumber() : -1);
+      [_swiftInteropBridge callFunction:methodName onModule:moduleName withArgs:swiftArguments resolve:resolve reject:reject];
+      return;
+    }
+
+    ABI45_0_0EXExportedModule *module = [_exModuleRegistry getExportedModuleForName:moduleName];
+    if (module == nil) {
+      NSString *reason = [NSString stringWithFormat:@"No exported module was found for name '%@'. Are you sure all the packages are linked correctly?", moduleName];
+      reject(@"E_NO_MODULE", reason, nil);
+      return;
+    }
+
+    ABI45_0_0EXExportedMethodsTable *methodsTable = [ABI45_0_0EXExportedMethodsTable tableForExportedModule:module];
+    ABI45_0_0EXExportedMethod *method;
+    if (methodNameOrKey.isNumber()) {
+      double methodKey = methodNameOrKey.getNumber();
+      method = methodKey >= 0 ? [methodsTable methodForKey:(NSUInteger)methodKey] : nil;
+    } else if (methodNameOrKey.isString()) {
+      method = [methodsTable methodForName:[NSString stringWithUTF8String:methodNameOrKey.getString(runtime).utf8(runtime).c_str()]];
+    } else {
+      reject(@"E_INV_MKEY", @"Method key is neither a String nor an Integer -- don't know how to map it to method name.", nil);
+      return;
+    }
+
+    if (method == nil || method.signature == nil) {
+      reject(@"E_NO_METHOD", [NSString stringWithFormat:@"Method '%@' of module '%@' is not exported.", [NSString stringWithUTF8String:methodNameOrKey.toString(runtime).utf8(runtime).c_str()], moduleName], nil);
+      return;
+    }
+    if (argumentsCount != method.argumentsCount) {
+      NSString *reason = [NSString stringWithFormat:@"Native method `%@.%@` expects %lu arguments, but received %zu.", moduleName, method.name, (unsigned long)method.argumentsCount, argumentsCount];
+      reject(@"E_INV_ARGC", reason, nil);
+      return;
+    }
+
+    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:method.signature];
+    // Retaining arguments before they are set makes the invocation retain (and copy blocks) as they are set.
+    // Otherwise objects converted from JS values would only be referenced by autoreleased locals.
+    [invocation retainArguments];
+    [invocation setTarget:module];
+    [invocation setSelector:method.selector];
+    for (size_t i = 0; i < argumentsCount; i++) {
+      ABI45_0_0expo::setInvocationArgument(invocation, 2 + i, runtime, arguments.getValueAtIndex(runtime, i), callInvoker);
+    }
+    [invocation setArgument:&resolve atIndex:2 + argumentsCount];
+    [invocation setArgument:&reject atIndex:2 + argumentsCount + 1];
+
+    [self dispatchCallOfMethod:method.name toModule:module block:^{
+      @try {
+        [invocation invoke];
+      } @catch (NSException *e) {
+        NSString *message = [NSString stringWithFormat:@"An exception was thrown while calling `%@.%@`: %@", moduleName, method.name, e];
+        reject(@"E_EXC", message, nil);
+      }
+    }];
+  });
+}
+
+/**
+ Implements `ExpoModules.NativeModulesProxy.callMethodSync(moduleName, methodName, arguments)`, the JSI counterpart
+ of `callMethodSync:methodName:arguments:`. `ArrayBuffer`, typed array and `DataView` arguments are copied once
+ to `NSData` and returned `NSData` becomes a new `ArrayBuffer`, instead of being converted to arrays of numbers.
+ */
+- (jsi::Value)callMethodSyncInRuntime:(jsi::Runtime &)runtime arguments:(const jsi::Value *)args count:(size_t)count
+{
+  if (count != 3 || !args[0].isString() || !args[1].isString() || !args[2].isObject() || !args[2].getObject(runtime).isArray(runtime)) {
+    throw jsi::JSError(runtime, "callMethodSync expects a module name, a method name and an array of arguments");
+  }
+
+  NSString *moduleName = [NSString stringWithUTF8String:args[0].getString(runtime).utf8(runtime).c_str()];
+  NSString *methodName = [NSString stringWithUTF8String:args[1].getString(runtime).utf8(runtime).c_str()];
+  jsi::Array jsArguments = args[2].getObject(runtime).getArray(runtime);
+  size_t argumentsCount = jsArguments.size(runtime);
+  std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker = _bridge.jsCallInvoker;
+
+  NSMutableArray *arguments = [NSMutableArray arrayWithCapacity:argumentsCount];
+  for (size_t i = 0; i < argumentsCount; i++) {
+    [arguments addObject:ABI45_0_0expo::convertCallArgument(runtime, jsArguments.getValueAtIndex(runtime, i), callInvoker) ?: [NSNull null]];
+  }
+
+  id result = [self callMethodSync:moduleName methodName:methodName arguments:arguments];
+  return ABI45_0_0expo::convertCallResult(runtime, result);
 }
 
 @end
@@ -0,0 +1,37 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <Foundation/Foundation.h>
+
+@class ABI45_0_0EXNativeModulesProxy;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Measures the "on mount" scenario of the proxy: the given method of the given module is called a number of times
+// back-to-back, like components do when a screen mounts, first through `callMethod` and then through `callMethodSync`.
+// The report follows the layout of Google Benchmark JSON output, so reports of native text benchmarks and of the proxy
+// can be stored and compared the same way: a `benchmarks` array of `{ name, real_time, time_unit, p50, p90, p99, retained_blocks, errors }`.
+// `real_time` is the wall time per call, percentiles are of the latency of a single call (from issuing the call
+// to its settlement) and `retained_blocks` is the growth of the number of heap blocks in use (of all threads) per call,
+// between the first call and the settlement of the last one. It is not an allocation count: blocks allocated and freed
+// during the run are not seen, which is why the name differs from `allocs` of the native text benchmarks.
+// Times are in microseconds.
+@interface ABI45_0_0EXNativeModulesProxyBenchmark : NSObject
+
+- (instancetype)initWithProxy:(ABI45_0_0EXNativeModulesProxy *)proxy;
+
+// Runs the benchmark and calls the completion with the report on a background queue. Options are:
+// - `moduleName`, `methodName` (required) and `arguments` of the called method,
+// - `calls` — the number of calls per scenario, 1000 by default,
+// - `sync` — whether to also run the scenario through `callMethodSync`, `YES` by default,
+// - `baseline` — a previously recorded report to compare against, in which case the report also contains a `regressions` array
+//   of names of benchmarks whose wall time grew by more than `maxRegression` (0.1 by default) or whose `retained_blocks` grew.
+- (void)runWithOptions:(NSDictionary<NSString *, id> *)options completion:(void (^)(NSDictionary<NSString *, id> *report))completion;
+
+// Returns names of benchmarks in the report that regressed compared to the same benchmarks in the baseline report.
++ (NSArray<NSString *> *)regressionsOfReport:(NSDictionary<NSString *, id> *)report
+                             againstBaseline:(NSDictionary<NSString *, id> *)baseline
+                               maxRegression:(double)maxRegression;
+
+@end
+
+NS_ASSUME_NONNULL_END
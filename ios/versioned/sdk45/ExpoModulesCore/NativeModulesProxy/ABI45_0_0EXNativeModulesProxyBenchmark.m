@@ -0,0 +1,218 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <malloc/malloc.h>
+#import <stdatomic.h>
+#import <time.h>
+
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXNativeModulesProxy.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXNativeModulesProxyBenchmark.h>
+
+static const NSUInteger defaultCallsCount = 1000;
+static const double defaultMaxRegression = 0.1;
+
+// Growth of `retained_blocks` that is not reported as a regression, absorbing blocks retained by unrelated threads meanwhile.
+static const double retainedBlocksTolerance = 0.5;
+
+static uint64_t now(void)
+{
+  return clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+}
+
+static size_t blocksInUse(void)
+{
+  malloc_statistics_t statistics;
+  malloc_zone_statistics(NULL, &statistics);
+  return statistics.blocks_in_use;
+}
+
+static int compareLatencies(const void *a, const void *b)
+{
+  uint64_t lhs = *(const uint64_t *)a;
+  uint64_t rhs = *(const uint64_t *)b;
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+// Nearest-rank percentile of sorted latencies, in microseconds.
+static double percentile(const uint64_t *sortedLatencies, NSUInteger count, double fraction)
+{
+  NSUInteger rank = (NSUInteger)ceil(fraction * count);
+  return (double)sortedLatencies[MAX(rank, 1) - 1] / NSEC_PER_USEC;
+}
+
+@interface ABI45_0_0EXNativeModulesProxyBenchmark ()
+
+@property (nonatomic, weak) ABI45_0_0EXNativeModulesProxy *proxy;
+
+@end
+
+@implementation ABI45_0_0EXNativeModulesProxyBenchmark
+
+- (instancetype)initWithProxy:(ABI45_0_0EXNativeModulesProxy *)proxy
+{
+  if (self = [super init]) {
+    _proxy = proxy;
+  }
+  return self;
+}
+
+- (void)runWithOptions:(NSDictionary<NSString *, id> *)options completion:(void (^)(NSDictionary<NSString *, id> *))completion
+{
+  NSString *moduleName = options[@"moduleName"];
+  NSString *methodName = options[@"methodName"];
+  NSArray *arguments = options[@"arguments"] ?: @[];
+  NSUInteger callsCount = [options[@"calls"] unsignedIntegerValue] ?: defaultCallsCount;
+  BOOL runsSync = options[@"sync"] ? [options[@"sync"] boolValue] : YES;
+  NSDictionary *baseline = options[@"baseline"];
+  double maxRegression = options[@"maxRegression"] ? [options[@"maxRegression"] doubleValue] : defaultMaxRegression;
+  NSString *scenarioName = [NSString stringWithFormat:@"%@.%@/calls:%lu", moduleName, methodName, (unsigned long)callsCount];
+
+  [self measureAsyncCallsOf:methodName ofModule:moduleName arguments:arguments count:callsCount completion:^(NSDictionary *asyncResult) {
+    NSMutableArray<NSDictionary *> *benchmarks = [NSMutableArray array];
+    [benchmarks addObject:[self benchmarkNamed:[@"BM_CallMethodOnMount/" stringByAppendingString:scenarioName] result:asyncResult]];
+
+    if (runsSync) {
+      NSDictionary *syncResult = [self measureSyncCallsOf:methodName ofModule:moduleName arguments:arguments count:callsCount];
+      [benchmarks addObject:[self benchmarkNamed:[@"BM_CallMethodSyncOnMount/" stringByAppendingString:scenarioName] result:syncResult]];
+    }
+
+    NSMutableDictionary *report = [NSMutableDictionary dictionaryWithObject:benchmarks forKey:@"benchmarks"];
+    if (baseline) {
+      report[@"regressions"] = [ABI45_0_0EXNativeModulesProxyBenchmark regressionsOfReport:report againstBaseline:baseline maxRegression:maxRegression];
+    }
+    completion(report);
+  }];
+}
+
++ (NSArray<NSString *> *)regressionsOfReport:(NSDictionary<NSString *, id> *)report
+                             againstBaseline:(NSDictionary<NSString *, id> *)baseline
+                               maxRegression:(double)maxRegression
+{
+  NSMutableDictionary<NSString *, NSDictionary *> *baselineBenchmarks = [NSMutableDictionary dictionary];
+  for (NSDictionary *benchmark in baseline[@"benchmarks"]) {
+    baselineBenchmarks[benchmark[@"name"]] = benchmark;
+  }
+
+  NSMutableArray<NSString *> *regressions = [NSMutableArray array];
+  for (NSDictionary *benchmark in report[@"benchmarks"]) {
+    NSDictionary *baselineBenchmark = baselineBenchmarks[benchmark[@"name"]];
+    if (!baselineBenchmark) {
+      continue;
+    }
+    double time = [benchmark[@"real_time"] doubleValue];
+    double baselineTime = [baselineBenchmark[@"real_time"] doubleValue];
+    BOOL timeRegressed = baselineTime > 0 && time > baselineTime * (1 + maxRegression);
+    BOOL retainedBlocksRegressed = baselineBenchmark[@"retained_blocks"]
+      && [benchmark[@"retained_blocks"] doubleValue] > [baselineBenchmark[@"retained_blocks"] doubleValue] + retainedBlocksTolerance;
+    if (timeRegressed || retainedBlocksRegressed) {
+      [regressions addObject:benchmark[@"name"]];
+    }
+  }
+  return regressions;
+}
+
+#pragma mark - Scenarios
+
+// Issues all the calls at once and waits for all of them to settle, recording the latency of each call.
+- (void)measureAsyncCallsOf:(NSString *)methodName
+                   ofModule:(NSString *)moduleName
+                  arguments:(NSArray *)arguments
+                      count:(NSUInteger)count
+                 completion:(void (^)(NSDictionary *result))completion
+{
+  ABI45_0_0EXNativeModulesProxy *proxy = _proxy;
+  NSMutableData *latenciesData = [NSMutableData dataWithLength:count * sizeof(uint64_t)];
+  uint64_t *latencies = (uint64_t *)latenciesData.mutableBytes;
+  __block atomic_uint errorsCount = 0;
+  dispatch_group_t group = dispatch_group_create();
+
+  size_t blocksBefore = blocksInUse();
+  uint64_t startTime = now();
+
+  for (NSUInteger i = 0; i < count; i++) {
+    dispatch_group_enter(group);
+    uint64_t callTime = now();
+
+    [proxy callMethod:moduleName methodNameOrKey:methodName arguments:arguments resolver:^(id result) {
+      latencies[i] = now() - callTime;
+      dispatch_group_leave(group);
+    } rejecter:^(NSString *code, NSString *message, NSError *error) {
+      latencies[i] = now() - callTime;
+      atomic_fetch_add(&errorsCount, 1);
+      dispatch_group_leave(group);
+    }];
+  }
+
+  dispatch_group_notify(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+    uint64_t endTime = now();
+    size_t blocksAfter = blocksInUse();
+
+    completion([self resultWithLatencies:latenciesData
+                                   count:count
+                                duration:endTime - startTime
+                          retainedBlocks:(double)blocksAfter - (double)blocksBefore
+                                  errors:atomic_load(&errorsCount)]);
+  });
+}
+
+// Calls the method synchronously one call after another. Failed calls return `NSNull`, so errors are not counted.
+- (NSDictionary *)measureSyncCallsOf:(NSString *)methodName
+                            ofModule:(NSString *)moduleName
+                           arguments:(NSArray *)arguments
+                               count:(NSUInteger)count
+{
+  ABI45_0_0EXNativeModulesProxy *proxy = _proxy;
+  NSMutableData *latenciesData = [NSMutableData dataWithLength:count * sizeof(uint64_t)];
+  uint64_t *latencies = (uint64_t *)latenciesData.mutableBytes;
+
+  size_t blocksBefore = blocksInUse();
+  uint64_t startTime = now();
+
+  for (NSUInteger i = 0; i < count; i++) {
+    @autoreleasepool {
+      uint64_t callTime = now();
+      [proxy callMethodSync:moduleName methodName:methodName arguments:arguments];
+      latencies[i] = now() - callTime;
+    }
+  }
+
+  uint64_t endTime = now();
+  size_t blocksAfter = blocksInUse();
+
+  return [self resultWithLatencies:latenciesData
+                             count:count
+                          duration:endTime - startTime
+                    retainedBlocks:(double)blocksAfter - (double)blocksBefore
+                            errors:0];
+}
+
+#pragma mark - Report
+
+- (NSDictionary *)resultWithLatencies:(NSMutableData *)latenciesData
+                                count:(NSUInteger)count
+                             duration:(uint64_t)duration
+                       retainedBlocks:(double)retainedBlocks
+                               errors:(NSUInteger)errors
+{
+  uint64_t *latencies = (uint64_t *)latenciesData.mutableBytes;
+  qsort(latencies, count, sizeof(uint64_t), compareLatencies);
+
+  return @{
+    @"real_time": @((double)duration / NSEC_PER_USEC / count),
+    @"p50": @(percentile(latencies, count, 0.5)),
+    @"p90": @(percentile(latencies, count, 0.9)),
+    @"p99": @(percentile(latencies, count, 0.99)),
+    @"retained_blocks": @(MAX(retainedBlocks, 0) / count),
+    @"errors": @(errors),
+  };
+}
+
+- (NSDictionary *)benchmarkNamed:(NSString *)name result:(NSDictionary *)result
+{
+  NSMutableDictionary *benchmark = [result mutableCopy];
+  benchmark[@"name"] = name;
+  benchmark[@"iterations"] = @1;
+  benchmark[@"time_unit"] = @"us";
+  return benchmark;
+}
+
+@end
@@ -0,0 +1,72 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#ifdef __cplusplus
+
+#import <functional>
+#import <memory>
+#import <optional>
+
+#import <ABI45_0_0jsi/ABI45_0_0jsi.h>
+#import <ABI45_0_0ReactCommon/ABI45_0_0CallInvoker.h>
+#import <ABI45_0_0React/ABI45_0_0RCTBridgeModule.h>
+
+namespace jsi = ABI45_0_0facebook::jsi;
+
+namespace ABI45_0_0expo {
+
+using PromiseExecutor = std::function<void(ABI45_0_0RCTPromiseResolveBlock resolve, ABI45_0_0RCTPromiseRejectBlock reject)>;
+
+/**
+ Creates a JS promise and synchronously calls the executor with blocks settling it.
+ The blocks can be called from any thread, the promise is settled on the JS thread through the call invoker.
+ The JS functions settling the promise are released on the JS thread as well, even if the blocks are never called.
+ */
+jsi::Value createPromise(jsi::Runtime &runtime,
+                         std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker,
+                         PromiseExecutor executor);
+
+/**
+ Memory of an `ArrayBuffer`, or of the part of it viewed by a typed array or `DataView`.
+ */
+struct ArrayBufferBytes {
+  uint8_t *data;
+  size_t length;
+};
+
+/**
+ Returns the memory of the buffer if the value is an `ArrayBuffer`, a typed array or a `DataView`.
+ Views are the objects for which `ArrayBuffer.isView` returns `true`; their `byteOffset` and `byteLength` must be
+ integers within the bounds of their `buffer`, otherwise the value is not treated as a buffer.
+ The pointer is valid only as long as the JS object is kept alive and is not detached.
+ */
+std::optional<ArrayBufferBytes> getArrayBufferBytes(jsi::Runtime &runtime, const jsi::Value &value);
+
+/**
+ Converts the JS argument of a native call. The native side may outlive the call, so buffers
+ are copied (once) to `NSData` instead of being converted to strings or arrays of numbers.
+ */
+id convertCallArgument(jsi::Runtime &runtime,
+                       const jsi::Value &value,
+                       std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker);
+
+/**
+ Converts the result of a native call. `NSData` is converted to a new `ArrayBuffer`.
+ */
+jsi::Value convertCallResult(jsi::Runtime &runtime, id result);
+
+/**
+ Sets the invocation's argument at given index straight from the JS value.
+ Numbers and booleans are passed as primitives or as `NSNumber`, depending on the argument type in the method signature.
+ Strings are passed as `NSString`, buffers as `NSData`, `null` and `undefined` as `nil`,
+ and other values are converted to Foundation objects. Converted objects are only kept alive by the invocation,
+ so it must already retain its arguments (see `-[NSInvocation retainArguments]`).
+ */
+void setInvocationArgument(NSInvocation *invocation,
+                           NSUInteger index,
+                           jsi::Runtime &runtime,
+                           const jsi::Value &value,
+                           std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker);
+
+} // namespace ABI45_0_0expo
+
+#endif
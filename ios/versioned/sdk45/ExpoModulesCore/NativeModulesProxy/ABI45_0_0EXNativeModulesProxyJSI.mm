@@ -0,0 +1,240 @@
+// Copyright 2018-present 650 Industries. All rights reserved.
+
+#import <cmath>
+#import <objc/runtime.h>
+
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXNativeModulesProxyJSI.h>
+#import <ABI45_0_0ExpoModulesCore/ABI45_0_0EXJSIConversions.h>
+
+namespace ABI45_0_0expo {
+
+/**
+ JS functions settling a promise. They are released on the JS thread once the promise is settled.
+ */
+struct PromiseCallbacks {
+  std::optional<jsi::Function> resolve;
+  std::optional<jsi::Function> reject;
+};
+
+/**
+ Owner of the promise callbacks shared by the blocks settling the promise. The blocks may be released on any thread,
+ also without having been called when the native method never settles the promise, so the owner hands the callbacks
+ over to the JS thread to release them there.
+ */
+class PromiseCallbacksOwner {
+public:
+  PromiseCallbacksOwner(std::shared_ptr<PromiseCallbacks> callbacks, std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker)
+    : callbacks_(std::move(callbacks)), callInvoker_(std::move(callInvoker)) {}
+
+  ~PromiseCallbacksOwner()
+  {
+    callInvoker_->invokeAsync([callbacks = std::move(callbacks_)]() mutable {
+      callbacks.reset();
+    });
+  }
+
+  PromiseCallbacks &callbacks()
+  {
+    return *callbacks_;
+  }
+
+private:
+  std::shared_ptr<PromiseCallbacks> callbacks_;
+  std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker_;
+};
+
+jsi::Value createPromise(jsi::Runtime &runtime,
+                         std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker,
+                         PromiseExecutor executor)
+{
+  jsi::Function promiseConstructor = runtime.global().getPropertyAsFunction(runtime, "Promise");
+  jsi::Function promiseExecutor = jsi::Function::createFromHostFunction(runtime, jsi::PropNameID::forAscii(runtime, "executor"), 2, [callInvoker, executor](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *args, size_t count) -> jsi::Value {
+    auto callbacks = std::make_shared<PromiseCallbacks>();
+    callbacks->resolve = args[0].getObject(runtime).getFunction(runtime);
+    callbacks->reject = args[1].getObject(runtime).getFunction(runtime);
+    auto owner = std::make_shared<PromiseCallbacksOwner>(callbacks, callInvoker);
+    jsi::Runtime *runtimePointer = &runtime;
+
+    ABI45_0_0RCTPromiseResolveBlock resolve = ^(id result) {
+      callInvoker->invokeAsync([owner, runtimePointer, result]() {
+        PromiseCallbacks &callbacks = owner->callbacks();
+        if (callbacks.resolve) {
+          callbacks.resolve->call(*runtimePointer, convertObjCObjectToJSIValue(*runtimePointer, result ?: [NSNull null]));
+        }
+        callbacks.resolve.reset();
+        callbacks.reject.reset();
+      });
+    };
+    ABI45_0_0RCTPromiseRejectBlock reject = ^(NSString *code, NSString *message, NSError *error) {
+      callInvoker->invokeAsync([owner, runtimePointer, code, message]() {
+        jsi::Runtime &runtime = *runtimePointer;
+        PromiseCallbacks &callbacks = owner->callbacks();
+        if (callbacks.reject) {
+          jsi::Function errorConstructor = runtime.global().getPropertyAsFunction(runtime, "Error");
+          jsi::Object jsError = errorConstructor.callAsConstructor(runtime, jsi::String::createFromUtf8(runtime, [message ?: @"" UTF8String])).getObject(runtime);
+          jsError.setProperty(runtime, "code", jsi::String::createFromUtf8(runtime, [code ?: @"E_UNKNOWN" UTF8String]));
+          callbacks.reject->call(runtime, std::move(jsError));
+        }
+        callbacks.resolve.reset();
+        callbacks.reject.reset();
+      });
+    };
+
+    executor(resolve, reject);
+    return jsi::Value::undefined();
+  });
+
+  return promiseConstructor.callAsConstructor(runtime, std::move(promiseExecutor));
+}
+
+/**
+ Returns whether the value is an integral number between 0 and `max`, and stores it in `result` if so.
+ NaN and infinities are rejected, so the value can be safely converted to `size_t`.
+ */
+static bool getByteIndex(const jsi::Value &value, size_t max, size_t &result)
+{
+  if (!value.isNumber()) {
+    return false;
+  }
+  double number = value.getNumber();
+  if (!std::isfinite(number) || number < 0 || number > (double)max || std::trunc(number) != number) {
+    return false;
+  }
+  result = (size_t)number;
+  return true;
+}
+
+std::optional<ArrayBufferBytes> getArrayBufferBytes(jsi::Runtime &runtime, const jsi::Value &value)
+{
+  if (!value.isObject()) {
+    return std::nullopt;
+  }
+  jsi::Object object = value.getObject(runtime);
+  if (object.isArrayBuffer(runtime)) {
+    jsi::ArrayBuffer arrayBuffer = object.getArrayBuffer(runtime);
+    return ArrayBufferBytes{arrayBuffer.data(runtime), arrayBuffer.size(runtime)};
+  }
+
+  // JSI has no API for typed arrays, so views are recognized with `ArrayBuffer.isView`. It is only looked up
+  // for objects with an `ArrayBuffer` in their `buffer` property, so other object arguments don't pay for it.
+  if (object.isArray(runtime) || object.isFunction(runtime)) {
+    return std::nullopt;
+  }
+  jsi::Value buffer = object.getProperty(runtime, "buffer");
+  if (!buffer.isObject() || !buffer.getObject(runtime).isArrayBuffer(runtime)) {
+    return std::nullopt;
+  }
+  jsi::Function isView = runtime.global()
+    .getPropertyAsObject(runtime, "ArrayBuffer")
+    .getPropertyAsFunction(runtime, "isView");
+  jsi::Value isViewResult = isView.call(runtime, value);
+  if (!isViewResult.isBool() || !isViewResult.getBool()) {
+    return std::nullopt;
+  }
+
+  jsi::ArrayBuffer arrayBuffer = buffer.getObject(runtime).getArrayBuffer(runtime);
+  size_t size = arrayBuffer.size(runtime);
+  size_t byteOffset = 0;
+  size_t byteLength = 0;
+  if (!getByteIndex(object.getProperty(runtime, "byteOffset"), size, byteOffset)
+      || !getByteIndex(object.getProperty(runtime, "byteLength"), size - byteOffset, byteLength)) {
+    return std::nullopt;
+  }
+  return ArrayBufferBytes{arrayBuffer.data(runtime) + byteOffset, byteLength};
+}
+
+id convertCallArgument(jsi::Runtime &runtime,
+                       const jsi::Value &value,
+                       std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker)
+{
+  if (auto bytes = getArrayBufferBytes(runtime, value)) {
+    return [NSData dataWithBytes:bytes->data length:bytes->length];
+  }
+  return convertJSIValueToObjCObject(runtime, value, callInvoker);
+}
+
+jsi::Value convertCallResult(jsi::Runtime &runtime, id result)
+{
+  if ([result isKindOfClass:[NSData class]]) {
+    // JSI cannot wrap native memory in an `ArrayBuffer`, so the data is copied into a new one.
+    NSData *data = (NSData *)result;
+    jsi::Function arrayBufferConstructor = runtime.global().getPropertyAsFunction(runtime, "ArrayBuffer");
+    jsi::ArrayBuffer arrayBuffer = arrayBufferConstructor
+      .callAsConstructor(runtime, (double)data.length)
+      .getObject(runtime)
+      .getArrayBuffer(runtime);
+    [data getBytes:arrayBuffer.data(runtime) length:data.length];
+    return jsi::Value(std::move(arrayBuffer));
+  }
+  return result != nil ? convertObjCObjectToJSIValue(runtime, result) : jsi::Value::undefined();
+}
+
+template <typename T>
+static void setPrimitiveInvocationArgument(NSInvocation *invocation, NSUInteger index, T value)
+{
+  [invocation setArgument:&value atIndex:index];
+}
+
+/**
+ Sets a numeric argument, returns `false` if the argument type is not numeric.
+ */
+static bool setNumericInvocationArgument(NSInvocation *invocation, NSUInteger index, const char *argumentType, double number)
+{
+  switch (argumentType[0]) {
+    case _C_DBL: setPrimitiveInvocationArgument<double>(invocation, index, number); return true;
+    case _C_FLT: setPrimitiveInvocationArgument<float>(invocation, index, number); return true;
+    case _C_INT: setPrimitiveInvocationArgument<int>(invocation, index, number); return true;
+    case _C_UINT: setPrimitiveInvocationArgument<unsigned int>(invocation, index, number); return true;
+    case _C_SHT: setPrimitiveInvocationArgument<short>(invocation, index, number); return true;
+    case _C_USHT: setPrimitiveInvocationArgument<unsigned short>(invocation, index, number); return true;
+    case _C_LNG: setPrimitiveInvocationArgument<long>(invocation, index, number); return true;
+    case _C_ULNG: setPrimitiveInvocationArgument<unsigned long>(invocation, index, number); return true;
+    case _C_LNG_LNG: setPrimitiveInvocationArgument<long long>(invocation, index, number); return true;
+    case _C_ULNG_LNG: setPrimitiveInvocationArgument<unsigned long long>(invocation, index, number); return true;
+    case _C_CHR: setPrimitiveInvocationArgument<char>(invocation, index, number); return true;
+    case _C_UCHR: setPrimitiveInvocationArgument<unsigned char>(invocation, index, number); return true;
+    case _C_BOOL: setPrimitiveInvocationArgument<bool>(invocation, index, number != 0); return true;
+    default: return false;
+  }
+}
+
+void setInvocationArgument(NSInvocation *invocation,
+                           NSUInteger index,
+                           jsi::Runtime &runtime,
+                           const jsi::Value &value,
+                           std::shared_ptr<ABI45_0_0facebook::ABI45_0_0React::CallInvoker> callInvoker)
+{
+  const char *argumentType = [invocation.methodSignature getArgumentTypeAtIndex:index];
+  // Skip type qualifiers such as `const` (r), `in` (n) or `oneway` (V).
+  while (argumentType[0] != '\0' && strchr("rnNoORV", argumentType[0]) != nullptr) {
+    argumentType++;
+  }
+
+  if (value.isNull() || value.isUndefined()) {
+    return;
+  }
+  if (value.isNumber() && setNumericInvocationArgument(invocation, index, argumentType, value.getNumber())) {
+    return;
+  }
+  if (value.isBool() && setNumericInvocationArgument(invocation, index, argumentType, value.getBool() ? 1 : 0)) {
+    return;
+  }
+  if (argumentType[0] != _C_ID) {
+    // Leave the argument zeroed, as the value cannot be represented by its type.
+    return;
+  }
+
+  id object;
+  if (value.isNumber()) {
+    object = @(value.getNumber());
+  } else if (value.isBool()) {
+    object = @(value.getBool());
+  } else if (value.isString()) {
+    object = [NSString stringWithUTF8String:value.getString(runtime).utf8(runtime).c_str()];
+  } else {
+    object = convertCallArgument(runtime, value, callInvoker);
+  }
+  [invocation setArgument:&object atIndex:index];
+}
+
+} // namespace ABI45_0_0expo